@@ -13,21 +13,17 @@ export ID_CON_MN=$4
 
 if [ $? -ne 0 ]; then
     echo "シミュレーションに失敗"
-    rm *.tsv *.log
+    rm -f *.csv.gz *.log
     exit -1
 fi
 
 mkdir -p result-$1/$2/$3-$4
 rm -rf result-$1/$2/$3-$4/*
 
-mv app-delays-trace.tsv result-$1/$2/$3-$4/k-$1-app-delays-trace-$2-$3-$4.tsv
-mv drop-trace.tsv result-$1/$2/$3-$4/k-$1-drop-trace-$2-$3-$4.tsv
-mv rate-trace.tsv result-$1/$2/$3-$4/k-$1-rate-trace-$2-$3-$4.tsv
+mv app-delays-trace.csv.gz result-$1/$2/$3-$4/k-$1-app-delays-trace-$2-$3-$4.csv.gz
+mv drop-trace.csv.gz result-$1/$2/$3-$4/k-$1-drop-trace-$2-$3-$4.csv.gz
+mv rate-trace.csv.gz result-$1/$2/$3-$4/k-$1-rate-trace-$2-$3-$4.csv.gz
+mv kademlia-trace.csv.gz result-$1/$2/$3-$4/k-$1-kademlia-trace-$2-$3-$4.csv.gz
 mv $2-$3-$4.log result-$1/$2/$3-$4/k-$1-$2-$3-$4.log
 
-cd result-$1/$2/$3-$4
-/home/strea/t2c.sh k-$1-app-delays-trace-$2-$3-$4.tsv
-/home/strea/t2c.sh k-$1-drop-trace-$2-$3-$4.tsv
-/home/strea/t2c.sh k-$1-rate-trace-$2-$3-$4.tsv
-
 exit 0
@@ -22,6 +22,7 @@
 #include "default-simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 
 #include "ptr.h"
 #include "pointer.h"
@@ -29,6 +30,7 @@
 #include "log.h"
 
 #include <cmath>
+#include <iostream>
 
 
 /**
@@ -93,6 +95,11 @@ DefaultSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+#ifdef ENABLE_EVENT_PROFILING
+  // Destroy has reported the profile; discard it only now, after the
+  // dequeuing above, so that the drained events are in neither profile
+  EventProfiler::Get ()->Reset ();
+#endif /* ENABLE_EVENT_PROFILING */
   SimulatorImpl::DoDispose ();
 }
 void
@@ -109,6 +116,10 @@ DefaultSimulatorImpl::Destroy ()
           ev->Invoke ();
         }
     }
+
+#ifdef ENABLE_EVENT_PROFILING
+  EventProfiler::Get ()->Report (std::clog);
+#endif /* ENABLE_EVENT_PROFILING */
 }
 
 void
@@ -116,6 +127,9 @@ DefaultSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
 {
   NS_LOG_FUNCTION (this << schedulerFactory);
   Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+#ifdef ENABLE_EVENT_PROFILING
+  scheduler = EventProfiler::Get ()->Wrap (scheduler);
+#endif /* ENABLE_EVENT_PROFILING */
 
   if (m_events != 0)
     {
@@ -148,7 +162,11 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
+#ifdef ENABLE_EVENT_PROFILING
+  EventProfiler::Get ()->Invoke (next.impl);
+#else
   next.impl->Invoke ();
+#endif /* ENABLE_EVENT_PROFILING */
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
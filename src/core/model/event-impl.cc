@@ -52,6 +52,15 @@ EventImpl::Invoke (void)
     }
 }
 
+#ifdef ENABLE_EVENT_PROFILING
+void
+EventImpl::GetFunction (const void **data, std::size_t *size) const
+{
+  *data = 0;
+  *size = 0;
+}
+#endif /* ENABLE_EVENT_PROFILING */
+
 void
 EventImpl::Cancel (void)
 {
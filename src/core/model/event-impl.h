@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -66,6 +67,17 @@ public:
    */
   bool IsCancelled (void);
 
+#ifdef ENABLE_EVENT_PROFILING
+  /**
+   * Get the function or method pointer called by Notify(), which
+   * EventProfiler uses to tell apart events of the same type.
+   *
+   * \param [out] data The address of the pointer, or 0 if unknown.
+   * \param [out] size The size of the pointer.
+   */
+  virtual void GetFunction (const void **data, std::size_t *size) const;
+#endif /* ENABLE_EVENT_PROFILING */
+
 protected:
   /**
    * Implementation for Invoke().
@@ -81,4 +93,20 @@ private:
 
 } // namespace ns3
 
+/**
+ * \ingroup events
+ * Implement EventImpl::GetFunction() in an EventImpl subclass which
+ * stores the called function or method pointer in \c m_function.
+ */
+#ifdef ENABLE_EVENT_PROFILING
+#define NS_EVENT_IMPL_GET_FUNCTION                                      \
+  virtual void GetFunction (const void **data, std::size_t *size) const \
+  {                                                                     \
+    *data = &m_function;                                                \
+    *size = sizeof (m_function);                                        \
+  }
+#else
+#define NS_EVENT_IMPL_GET_FUNCTION
+#endif /* ENABLE_EVENT_PROFILING */
+
 #endif /* EVENT_IMPL_H */
@@ -0,0 +1,374 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "log.h"
+#include "ns3/core-config.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#ifdef HAVE_DLADDR
+#include <dlfcn.h>
+#endif /* HAVE_DLADDR */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+/**
+ * \ingroup simulator
+ * \brief Scheduler decorator which reports to EventProfiler.
+ */
+class ProfilingScheduler : public Scheduler
+{
+public:
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Constructor.
+   *
+   * \param [in] scheduler The scheduler to wrap.
+   * \param [in] profiler The profiler to report to.
+   */
+  ProfilingScheduler (Ptr<Scheduler> scheduler, EventProfiler *profiler);
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /**
+   * Account a call of an operation.
+   *
+   * \param [in,out] stats The statistics of the operation.
+   * \param [in] start The time when the operation started.
+   */
+  static void Record (EventProfiler::OperationStats &stats,
+                      EventProfiler::Clock::time_point start);
+
+  Ptr<Scheduler> m_scheduler;  //!< The wrapped scheduler.
+  EventProfiler *m_profiler;   //!< The profiler.
+};
+
+NS_OBJECT_ENSURE_REGISTERED (ProfilingScheduler);
+
+TypeId
+ProfilingScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ProfilingScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+  ;
+  return tid;
+}
+
+ProfilingScheduler::ProfilingScheduler (Ptr<Scheduler> scheduler, EventProfiler *profiler)
+  : m_scheduler (scheduler),
+    m_profiler (profiler)
+{
+}
+
+void
+ProfilingScheduler::Record (EventProfiler::OperationStats &stats,
+                            EventProfiler::Clock::time_point start)
+{
+  stats.time += EventProfiler::Clock::now () - start;
+  stats.count++;
+}
+
+void
+ProfilingScheduler::Insert (const Scheduler::Event &ev)
+{
+  EventProfiler::Clock::time_point start = EventProfiler::Clock::now ();
+  m_scheduler->Insert (ev);
+  Record (m_profiler->m_inserts, start);
+
+  m_profiler->m_depth++;
+  m_profiler->m_maxDepth = std::max (m_profiler->m_maxDepth, m_profiler->m_depth);
+}
+
+bool
+ProfilingScheduler::IsEmpty (void) const
+{
+  return m_scheduler->IsEmpty ();
+}
+
+Scheduler::Event
+ProfilingScheduler::PeekNext (void) const
+{
+  return m_scheduler->PeekNext ();
+}
+
+Scheduler::Event
+ProfilingScheduler::RemoveNext (void)
+{
+  EventProfiler::Clock::time_point start = EventProfiler::Clock::now ();
+  Scheduler::Event ev = m_scheduler->RemoveNext ();
+  Record (m_profiler->m_removeNexts, start);
+
+  m_profiler->SampleDepth (ev.key.m_ts);
+  m_profiler->m_depth--;
+  return ev;
+}
+
+void
+ProfilingScheduler::Remove (const Scheduler::Event &ev)
+{
+  EventProfiler::Clock::time_point start = EventProfiler::Clock::now ();
+  m_scheduler->Remove (ev);
+  Record (m_profiler->m_removes, start);
+
+  m_profiler->m_depth--;
+}
+
+bool
+EventProfiler::EventKind::operator== (const EventKind &other) const
+{
+  return type == other.type && functionSize == other.functionSize &&
+         function == other.function;
+}
+
+std::size_t
+EventProfiler::EventKindHash::operator() (const EventKind &kind) const
+{
+  std::size_t hash = kind.type.hash_code ();
+  for (std::size_t i = 0; i < kind.functionSize; ++i)
+    {
+      hash = hash * 31 + kind.function[i];
+    }
+  return hash;
+}
+
+EventProfiler::EventProfiler ()
+  : m_depth (0),
+    m_depthInterval (Seconds (1).GetTimeStep ())
+{
+  Reset ();
+}
+
+Ptr<Scheduler>
+EventProfiler::Wrap (Ptr<Scheduler> scheduler)
+{
+  NS_LOG_FUNCTION (this << scheduler);
+  return CreateObject<ProfilingScheduler> (scheduler, this);
+}
+
+void
+EventProfiler::Invoke (EventImpl *event)
+{
+  EventKind kind = {typeid (*event), {}, 0};
+#ifdef ENABLE_EVENT_PROFILING
+  const void *function;
+  std::size_t size;
+  event->GetFunction (&function, &size);
+  if (function != 0 && size <= MAX_FUNCTION_SIZE)
+    {
+      std::memcpy (kind.function.data (), function, size);
+      kind.functionSize = size;
+    }
+#endif /* ENABLE_EVENT_PROFILING */
+
+  EventStats &stats = m_events[kind];
+  if (event->IsCancelled ())
+    {
+      stats.cancelled++;
+      return;
+    }
+
+  Clock::time_point start = Clock::now ();
+  event->Invoke ();
+  stats.time += Clock::now () - start;
+  stats.count++;
+}
+
+void
+EventProfiler::SetDepthSamplingInterval (Time interval)
+{
+  NS_LOG_FUNCTION (this << interval);
+  m_depthInterval = std::max<int64_t> (interval.GetTimeStep (), 1);
+}
+
+void
+EventProfiler::SampleDepth (uint64_t ts)
+{
+  int64_t now = static_cast<int64_t> (ts);
+  if (now >= m_nextDepthSample)
+    {
+      m_depthSamples.push_back (std::make_pair (now, m_depth));
+      m_nextDepthSample = (now / m_depthInterval + 1) * m_depthInterval;
+    }
+}
+
+void
+EventProfiler::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_events.clear ();
+  m_inserts = OperationStats ();
+  m_removes = OperationStats ();
+  m_removeNexts = OperationStats ();
+  // queued events are still counted by m_depth
+  m_maxDepth = m_depth;
+  m_nextDepthSample = 0;
+  m_depthSamples.clear ();
+}
+
+std::string
+EventProfiler::GetName (const EventKind &kind)
+{
+  std::string name = kind.type.name ();
+  int status;
+  char *demangled = abi::__cxa_demangle (name.c_str (), 0, 0, &status);
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+
+  if (kind.functionSize == 0)
+    {
+      return name;
+    }
+
+  // The first word of a function pointer, and of a pointer to member
+  // function in the Itanium C++ ABI, is the code address, or 1 plus the
+  // vtable offset for virtual methods.
+  uintptr_t address;
+  std::memcpy (&address, kind.function.data (), sizeof (address));
+  std::ostringstream os;
+  if (kind.functionSize > sizeof (address) && (address & 1) != 0)
+    {
+      os << name << " [virtual, vtable offset " << address - 1 << "]";
+      return os.str ();
+    }
+
+#ifdef HAVE_DLADDR
+  Dl_info info;
+  if (dladdr (reinterpret_cast<void *> (address), &info) != 0 &&
+      info.dli_sname != 0 && info.dli_saddr == reinterpret_cast<void *> (address))
+    {
+      demangled = abi::__cxa_demangle (info.dli_sname, 0, 0, &status);
+      std::string symbol = status == 0 ? demangled : info.dli_sname;
+      std::free (demangled);
+      return symbol;
+    }
+#endif /* HAVE_DLADDR */
+
+  os << name << " [0x" << std::hex << address << "]";
+  return os.str ();
+}
+
+void
+EventProfiler::Report (std::ostream &os) const
+{
+  typedef std::chrono::duration<double> Seconds;
+  typedef std::chrono::duration<double, std::micro> MicroSeconds;
+
+  // the same function scheduled with different argument types yields several kinds
+  std::map<std::string, EventStats> byName;
+  for (const auto &event : m_events)
+    {
+      EventStats &stats = byName[GetName (event.first)];
+      stats.count += event.second.count;
+      stats.cancelled += event.second.cancelled;
+      stats.time += event.second.time;
+    }
+
+  std::vector<std::pair<std::string, EventStats> > events (byName.begin (), byName.end ());
+  std::sort (events.begin (), events.end (),
+             [] (const std::pair<std::string, EventStats> &a,
+                 const std::pair<std::string, EventStats> &b) {
+               return a.second.time > b.second.time;
+             });
+
+  Clock::duration total = Clock::duration::zero ();
+  uint64_t count = 0;
+  for (const auto &event : events)
+    {
+      total += event.second.time;
+      count += event.second.count;
+    }
+
+  std::ios_base::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+  os << std::fixed;
+
+  os << "Event profile: " << count << " events, "
+     << std::setprecision (6) << Seconds (total).count () << " s\n";
+  os << std::setw (12) << "Count" << std::setw (10) << "Cancelled"
+     << std::setw (14) << "Time(s)" << std::setw (8) << "Share"
+     << std::setw (12) << "Mean(us)" << "  Event\n";
+  for (const auto &event : events)
+    {
+      const EventStats &stats = event.second;
+      double share = total.count () > 0 ? 100.0 * stats.time.count () / total.count () : 0;
+      double mean = stats.count > 0 ? MicroSeconds (stats.time).count () / stats.count : 0;
+      os << std::setw (12) << stats.count << std::setw (10) << stats.cancelled
+         << std::setprecision (6) << std::setw (14) << Seconds (stats.time).count ()
+         << std::setprecision (1) << std::setw (7) << share << "%"
+         << std::setprecision (3) << std::setw (12) << mean
+         << "  " << event.first << "\n";
+    }
+
+  os << "Scheduler operations:\n";
+  const std::pair<const char *, const OperationStats *> operations[] = {
+    std::make_pair ("Insert", &m_inserts),
+    std::make_pair ("Remove", &m_removes),
+    std::make_pair ("RemoveNext", &m_removeNexts),
+  };
+  for (const auto &operation : operations)
+    {
+      const OperationStats &stats = *operation.second;
+      double mean = stats.count > 0 ? MicroSeconds (stats.time).count () / stats.count : 0;
+      os << std::setw (12) << stats.count
+         << std::setprecision (6) << std::setw (24) << Seconds (stats.time).count ()
+         << std::setprecision (3) << std::setw (20) << mean
+         << "  " << operation.first << "\n";
+    }
+
+  os << "Queue depth: max " << m_maxDepth << "\n";
+  os << std::setw (16) << "Time(s)" << std::setw (12) << "Depth" << "\n";
+  for (const auto &sample : m_depthSamples)
+    {
+      os << std::setprecision (6) << std::setw (16) << TimeStep (sample.first).GetSeconds ()
+         << std::setw (12) << sample.second << "\n";
+    }
+
+  os.flags (flags);
+  os.precision (precision);
+}
+
+} // namespace ns3
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+#include "nstime.h"
+#include "ptr.h"
+#include "scheduler.h"
+#include "singleton.h"
+
+#include <stdint.h>
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ * \brief Wall-clock profile of the events executed by DefaultSimulatorImpl.
+ *
+ * For every kind of event, the profiler records how many events were
+ * executed and how much wall-clock time they took.  The kind of an event
+ * is its EventImpl subclass, which MakeEvent() derives from the class and
+ * the signature of the scheduled method, together with the method or
+ * function pointer captured by MakeEvent().  Thus, for instance,
+ * PointToPointNetDevice::TransmitComplete and the forwarding of an NDN
+ * packet are reported separately.  Events scheduled as std::function
+ * (e.g., lambdas) share a single kind.
+ *
+ * The profiler also measures the wall-clock time spent in the Insert,
+ * Remove and RemoveNext operations of the scheduler, and samples the
+ * number of events in the queue over simulation time.
+ *
+ * The report is printed to std::clog when Simulator::Destroy is called.
+ *
+ * <b> Enabling the event profiler </b>
+ *
+ * Enable the profiler at configure time with
+ * \verbatim
+   $ waf configure ... --enable-event-profiling \endverbatim
+ * Otherwise, the simulator is not instrumented at all.
+ */
+class EventProfiler : public Singleton<EventProfiler>
+{
+public:
+  /** Clock used for all measurements. */
+  typedef std::chrono::steady_clock Clock;
+
+  /** Statistics of one kind of event. */
+  struct EventStats
+  {
+    uint64_t count;       //!< Number of executed events.
+    uint64_t cancelled;   //!< Number of events found cancelled when due.
+    Clock::duration time; //!< Cumulative wall-clock time of execution.
+  };
+
+  /** Statistics of one scheduler operation. */
+  struct OperationStats
+  {
+    uint64_t count;       //!< Number of calls.
+    Clock::duration time; //!< Cumulative wall-clock time.
+  };
+
+  /** Constructor. */
+  EventProfiler ();
+
+  /**
+   * Wrap a scheduler, so that its operations are timed and the number
+   * of queued events is tracked.
+   *
+   * \param [in] scheduler The scheduler to wrap.
+   * \returns The wrapping scheduler.
+   */
+  Ptr<Scheduler> Wrap (Ptr<Scheduler> scheduler);
+
+  /**
+   * Execute an event and record its wall-clock time.
+   *
+   * \param [in] event The event to execute.
+   */
+  void Invoke (EventImpl *event);
+
+  /**
+   * Set the simulation time between samples of the queue depth.
+   *
+   * \param [in] interval The sampling interval (default 1 s).
+   */
+  void SetDepthSamplingInterval (Time interval);
+
+  /**
+   * Print the profile.
+   *
+   * \param [in,out] os The output stream.
+   */
+  void Report (std::ostream &os) const;
+
+  /** Discard all recorded data. */
+  void Reset (void);
+
+private:
+  friend class ProfilingScheduler;
+
+  /** Largest method pointer that is told apart, in bytes. */
+  static const std::size_t MAX_FUNCTION_SIZE = 2 * sizeof (void *);
+
+  /** Kind of an event: its type and the bytes of its function pointer. */
+  struct EventKind
+  {
+    std::type_index type;                                //!< Dynamic type of the event.
+    std::array<unsigned char, MAX_FUNCTION_SIZE> function; //!< Function pointer, zero-padded.
+    std::size_t functionSize;                            //!< Size of the function pointer.
+
+    bool operator== (const EventKind &other) const;
+  };
+
+  /** Hash of EventKind. */
+  struct EventKindHash
+  {
+    std::size_t operator() (const EventKind &kind) const;
+  };
+
+  /**
+   * Get a printable name of an event kind.
+   *
+   * \param [in] kind The event kind.
+   * \returns The demangled type name, and the symbol of the function, if known.
+   */
+  static std::string GetName (const EventKind &kind);
+
+  /**
+   * Record the number of queued events.
+   *
+   * \param [in] ts The timestamp of the event being dequeued.
+   */
+  void SampleDepth (uint64_t ts);
+
+  /** Statistics of event kinds. */
+  std::unordered_map<EventKind, EventStats, EventKindHash> m_events;
+  OperationStats m_inserts;     //!< Scheduler::Insert statistics.
+  OperationStats m_removes;     //!< Scheduler::Remove statistics.
+  OperationStats m_removeNexts; //!< Scheduler::RemoveNext statistics.
+
+  uint64_t m_depth;             //!< Current number of queued events.
+  uint64_t m_maxDepth;          //!< Maximum number of queued events.
+  int64_t m_depthInterval;      //!< Depth sampling interval, in time steps.
+  int64_t m_nextDepthSample;    //!< Timestamp of the next depth sample.
+  /** Samples of (simulation time step, queue depth). */
+  std::vector<std::pair<int64_t, uint64_t> > m_depthSamples;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
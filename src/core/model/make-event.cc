@@ -54,6 +54,7 @@ protected:
     }
 private:
     F m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
   } *ev = new EventFunctionImpl0 (f);
   return ev;
 }
@@ -398,6 +398,7 @@ private:
     }
     OBJ m_obj;
     MEM m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
   } *ev = new EventMemberImpl0 (obj, mem_ptr);
   return ev;
 }
@@ -428,6 +429,7 @@ private:
     }
     OBJ m_obj;
     MEM m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventMemberImpl1 (obj, mem_ptr, a1);
   return ev;
@@ -459,6 +461,7 @@ private:
     }
     OBJ m_obj;
     MEM m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
   } *ev = new EventMemberImpl2 (obj, mem_ptr, a1, a2);
@@ -492,6 +495,7 @@ private:
     }
     OBJ m_obj;
     MEM m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
@@ -527,6 +531,7 @@ private:
     }
     OBJ m_obj;
     MEM m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
@@ -565,6 +570,7 @@ private:
     }
     OBJ m_obj;
     MEM m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
@@ -605,6 +611,7 @@ private:
     }
     OBJ m_obj;
     MEM m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
@@ -639,6 +646,7 @@ private:
       (*m_function)(m_a1);
     }
     F m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventFunctionImpl1 (f, a1);
   return ev;
@@ -669,6 +677,7 @@ private:
       (*m_function)(m_a1, m_a2);
     }
     F m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
   } *ev = new EventFunctionImpl2 (f, a1, a2);
@@ -702,6 +711,7 @@ private:
       (*m_function)(m_a1, m_a2, m_a3);
     }
     F m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
@@ -737,6 +747,7 @@ private:
       (*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
     F m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
@@ -774,6 +785,7 @@ private:
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
     F m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
@@ -813,6 +825,7 @@ private:
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
     F m_function;
+    NS_EVENT_IMPL_GET_FUNCTION
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
     typename TypeTraits<T3>::ReferencedType m_a3;
@@ -0,0 +1,290 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/event-profiler.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-profiler-tests EventProfiler test suite
+ */
+
+#ifdef ENABLE_EVENT_PROFILING
+
+namespace ns3 {
+
+  namespace tests {
+
+
+/**
+ * \ingroup event-profiler-tests
+ * Parsed EventProfiler::Report output.
+ */
+struct EventProfile
+{
+  /**
+   * Parse a report.
+   * \param [in] report The output of EventProfiler::Report.
+   */
+  explicit EventProfile (const std::string &report);
+
+  uint64_t count;                                   //!< Number of executed events.
+  std::multiset<std::pair<uint64_t, uint64_t> > kinds; //!< (count, cancelled) of each kind.
+  uint64_t inserts;                                 //!< Scheduler::Insert calls.
+  uint64_t removeNexts;                             //!< Scheduler::RemoveNext calls.
+  uint64_t maxDepth;                                //!< Maximum queue depth.
+  std::vector<std::pair<double, uint64_t> > depths; //!< (time, depth) samples.
+};
+
+EventProfile::EventProfile (const std::string &report)
+  : count (0),
+    inserts (0),
+    removeNexts (0),
+    maxDepth (0)
+{
+  std::istringstream is (report);
+  std::string line;
+  enum { HEADER, EVENTS, OPERATIONS, DEPTHS } section = HEADER;
+  while (std::getline (is, line))
+    {
+      std::istringstream fields (line);
+      std::string word;
+      if (line.compare (0, 14, "Event profile:") == 0)
+        {
+          fields >> word >> word >> count;
+        }
+      else if (line.find ("Cancelled") != std::string::npos)
+        {
+          section = EVENTS;
+        }
+      else if (line == "Scheduler operations:")
+        {
+          section = OPERATIONS;
+        }
+      else if (line.compare (0, 16, "Queue depth: max") == 0)
+        {
+          fields >> word >> word >> word >> maxDepth;
+          std::getline (is, line); // column headers
+          section = DEPTHS;
+        }
+      else if (section == EVENTS)
+        {
+          uint64_t eventCount, cancelled;
+          fields >> eventCount >> cancelled;
+          kinds.insert (std::make_pair (eventCount, cancelled));
+        }
+      else if (section == OPERATIONS)
+        {
+          uint64_t operationCount;
+          double time, mean;
+          fields >> operationCount >> time >> mean >> word;
+          if (word == "Insert")
+            {
+              inserts = operationCount;
+            }
+          else if (word == "RemoveNext")
+            {
+              removeNexts = operationCount;
+            }
+        }
+      else if (section == DEPTHS)
+        {
+          double time;
+          uint64_t depth;
+          fields >> time >> depth;
+          depths.push_back (std::make_pair (time, depth));
+        }
+    }
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Get the current profile.
+ * \returns The parsed report of the EventProfiler.
+ */
+static EventProfile
+GetProfile (void)
+{
+  std::ostringstream os;
+  EventProfiler::Get ()->Report (os);
+  return EventProfile (os.str ());
+}
+
+
+/**
+ * \ingroup event-profiler-tests
+ * Check that the events are counted separately for each kind.
+ */
+class EventProfilerKindsTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerKindsTestCase ();
+  virtual void DoRun (void);
+  /** First event method. */
+  void EventA (void);
+  /** Second event method, with the same signature. */
+  void EventB (void);
+};
+
+/** Event function. */
+static void
+EventFunction (void)
+{
+}
+
+EventProfilerKindsTestCase::EventProfilerKindsTestCase ()
+  : TestCase ("Check that events are counted per kind")
+{
+}
+
+void
+EventProfilerKindsTestCase::EventA (void)
+{
+}
+
+void
+EventProfilerKindsTestCase::EventB (void)
+{
+}
+
+void
+EventProfilerKindsTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+
+  Simulator::Schedule (MicroSeconds (1), &EventProfilerKindsTestCase::EventA, this);
+  Simulator::Schedule (MicroSeconds (2), &EventProfilerKindsTestCase::EventA, this);
+  EventId cancelled = Simulator::Schedule (MicroSeconds (3), &EventProfilerKindsTestCase::EventA, this);
+  Simulator::Schedule (MicroSeconds (1), &EventProfilerKindsTestCase::EventB, this);
+  Simulator::Schedule (MicroSeconds (4), &EventProfilerKindsTestCase::EventB, this);
+  Simulator::Schedule (MicroSeconds (2), &EventFunction);
+  cancelled.Cancel ();
+  Simulator::Run ();
+
+  EventProfile profile = GetProfile ();
+  NS_TEST_EXPECT_MSG_EQ (profile.count, 5, "Executed events");
+
+  std::multiset<std::pair<uint64_t, uint64_t> > kinds;
+  kinds.insert (std::make_pair (2, 1)); // EventA
+  kinds.insert (std::make_pair (2, 0)); // EventB
+  kinds.insert (std::make_pair (1, 0)); // EventFunction
+  NS_TEST_EXPECT_MSG_EQ ((profile.kinds == kinds), true, "Count and cancelled events of each kind");
+
+  NS_TEST_EXPECT_MSG_EQ (profile.inserts, 6, "Scheduler::Insert calls");
+  NS_TEST_EXPECT_MSG_EQ (profile.removeNexts, 6, "Scheduler::RemoveNext calls");
+  NS_TEST_EXPECT_MSG_EQ (profile.maxDepth, 6, "Maximum queue depth");
+
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup event-profiler-tests
+ * Check that the events dequeued by Simulator::Destroy are profiled
+ * in neither the destroyed nor the next simulation.
+ */
+class EventProfilerDestroyTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerDestroyTestCase ();
+  virtual void DoRun (void);
+  /** Event method. */
+  void Event (void);
+};
+
+EventProfilerDestroyTestCase::EventProfilerDestroyTestCase ()
+  : TestCase ("Check that events drained by Simulator::Destroy are not profiled")
+{
+}
+
+void
+EventProfilerDestroyTestCase::Event (void)
+{
+}
+
+void
+EventProfilerDestroyTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+
+  // the second event is still queued when the simulation is destroyed
+  Simulator::Schedule (Seconds (1), &EventProfilerDestroyTestCase::Event, this);
+  Simulator::Schedule (Seconds (10), &EventProfilerDestroyTestCase::Event, this);
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  Simulator::Schedule (Seconds (1), &EventProfilerDestroyTestCase::Event, this);
+  Simulator::Run ();
+
+  EventProfile profile = GetProfile ();
+  NS_TEST_EXPECT_MSG_EQ (profile.count, 1, "Executed events");
+  NS_TEST_EXPECT_MSG_EQ (profile.inserts, 1, "Scheduler::Insert calls");
+  NS_TEST_EXPECT_MSG_EQ (profile.removeNexts, 1, "Scheduler::RemoveNext calls");
+  NS_TEST_EXPECT_MSG_EQ (profile.maxDepth, 1, "Maximum queue depth");
+  NS_TEST_ASSERT_MSG_EQ (profile.depths.size (), 1, "Queue depth samples");
+  NS_TEST_EXPECT_MSG_EQ (profile.depths[0].first, 1.0, "Time of the queue depth sample");
+  NS_TEST_EXPECT_MSG_EQ (profile.depths[0].second, 1, "Sampled queue depth");
+
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  EventProfilerTestSuite ()
+    : TestSuite ("event-profiler")
+  {
+    AddTestCase (new EventProfilerKindsTestCase ());
+    AddTestCase (new EventProfilerDestroyTestCase ());
+  }
+};
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+
+  }  // namespace tests
+
+}  // namespace ns3
+
+#endif /* ENABLE_EVENT_PROFILING */
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "forwarder-profiler.hpp"
+
+#include <boost/io/ios_state.hpp>
+
+#include <iomanip>
+
+namespace nfd {
+namespace fw {
+
+std::ostream&
+operator<<(std::ostream& os, ForwarderStage stage)
+{
+  switch (stage) {
+    case ForwarderStage::INCOMING_INTEREST:
+      return os << "onIncomingInterest";
+    case ForwarderStage::PIT_INSERT:
+      return os << "pitInsert";
+    case ForwarderStage::CS_LOOKUP:
+      return os << "csLookup";
+    case ForwarderStage::DISPATCH_TO_STRATEGY:
+      return os << "dispatchToStrategy";
+    case ForwarderStage::LOOKUP_FIB:
+      return os << "lookupFib";
+    case ForwarderStage::LOOKUP_FIB_LIST:
+      return os << "lookupFibList";
+    case ForwarderStage::OUTGOING_INTEREST:
+      return os << "onOutgoingInterest";
+    case ForwarderStage::INCOMING_DATA:
+      return os << "onIncomingData";
+    case ForwarderStage::FIND_ALL_DATA_MATCHES:
+      return os << "findAllDataMatches";
+  }
+  return os << static_cast<int>(stage);
+}
+
+static ForwarderProfiler::Clock::duration
+extrapolate(ForwarderProfiler::Clock::duration sampled, uint64_t nSampledCalls, uint64_t nCalls)
+{
+  if (nSampledCalls == 0) {
+    return ForwarderProfiler::Clock::duration::zero();
+  }
+  return ForwarderProfiler::Clock::duration(static_cast<ForwarderProfiler::Clock::rep>(
+    static_cast<double>(sampled.count()) * nCalls / nSampledCalls));
+}
+
+ForwarderProfiler::Clock::duration
+ForwarderProfiler::StageStats::getInclusiveTime() const
+{
+  return extrapolate(sampledInclusiveTime, nSampledCalls, nCalls);
+}
+
+ForwarderProfiler::Clock::duration
+ForwarderProfiler::StageStats::getExclusiveTime() const
+{
+  return extrapolate(sampledExclusiveTime, nSampledCalls, nCalls);
+}
+
+ForwarderProfiler::ForwarderProfiler()
+  : m_samplingInterval(16)
+  , m_nOutermostCalls(0)
+  , m_current(nullptr)
+{
+}
+
+ForwarderProfiler&
+ForwarderProfiler::get()
+{
+  static ForwarderProfiler instance;
+  return instance;
+}
+
+void
+ForwarderProfiler::setSamplingInterval(size_t interval)
+{
+  m_samplingInterval = std::max<size_t>(interval, 1);
+}
+
+void
+ForwarderProfiler::reset()
+{
+  BOOST_ASSERT(m_current == nullptr);
+  m_stats.fill(StageStats());
+  m_nOutermostCalls = 0;
+}
+
+void
+ForwarderProfiler::print(std::ostream& os) const
+{
+  using std::chrono::duration;
+
+  boost::io::ios_all_saver saver(os);
+  os << std::left << std::setw(20) << "Stage" << std::right
+     << std::setw(14) << "Calls" << std::setw(12) << "Sampled"
+     << std::setw(14) << "Inclusive(s)" << std::setw(14) << "Exclusive(s)"
+     << std::setw(14) << "Self/call(ns)" << "\n";
+
+  os << std::fixed;
+  for (size_t i = 0; i < N_FORWARDER_STAGES; ++i) {
+    const StageStats& stats = m_stats[i];
+    if (stats.nCalls == 0) {
+      continue;
+    }
+
+    duration<double> inclusive = stats.getInclusiveTime();
+    duration<double> exclusive = stats.getExclusiveTime();
+    duration<double, std::nano> exclusivePerCall = exclusive / stats.nCalls;
+    os << std::left << std::setw(20) << static_cast<ForwarderStage>(i) << std::right
+       << std::setw(14) << stats.nCalls << std::setw(12) << stats.nSampledCalls
+       << std::setprecision(6)
+       << std::setw(14) << inclusive.count() << std::setw(14) << exclusive.count()
+       << std::setprecision(1)
+       << std::setw(14) << exclusivePerCall.count() << "\n";
+  }
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_FORWARDER_PROFILER_HPP
+#define NFD_DAEMON_FW_FORWARDER_PROFILER_HPP
+
+#include "core/common.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace nfd {
+namespace fw {
+
+/** \brief forwarding pipeline stages measured by ForwarderProfiler
+ */
+enum class ForwarderStage {
+  INCOMING_INTEREST,
+  PIT_INSERT,
+  CS_LOOKUP,
+  DISPATCH_TO_STRATEGY,
+  LOOKUP_FIB,
+  LOOKUP_FIB_LIST,
+  OUTGOING_INTEREST,
+  INCOMING_DATA,
+  FIND_ALL_DATA_MATCHES,
+};
+
+constexpr size_t N_FORWARDER_STAGES = static_cast<size_t>(ForwarderStage::FIND_ALL_DATA_MATCHES) + 1;
+
+std::ostream&
+operator<<(std::ostream& os, ForwarderStage stage);
+
+/** \brief accumulates wall-clock time and call counts of forwarding pipeline stages
+ *
+ *  Stages are measured by ScopedTimer objects, usually created through NFD_PROFILE_STAGE.
+ *  Every call is counted, but only one in every samplingInterval outermost stages is timed,
+ *  together with all stages nested in it, so that the clock is read rarely.  Totals are
+ *  extrapolated from the timed calls.
+ *
+ *  Inclusive time of a stage contains the stages nested in it, while exclusive time does not.
+ *  A stage nested in itself (e.g., Data returned synchronously in response to an Interest)
+ *  is counted more than once in inclusive time.
+ *
+ *  The profiler is not thread-safe.  All forwarders in a process share the instance returned
+ *  by get().
+ */
+class ForwarderProfiler : noncopyable
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct StageStats
+  {
+    uint64_t nCalls = 0;
+    uint64_t nSampledCalls = 0;
+    Clock::duration sampledInclusiveTime = Clock::duration::zero();
+    Clock::duration sampledExclusiveTime = Clock::duration::zero();
+
+    /** \return extrapolated inclusive time of all calls
+     */
+    Clock::duration
+    getInclusiveTime() const;
+
+    /** \return extrapolated exclusive time of all calls
+     */
+    Clock::duration
+    getExclusiveTime() const;
+  };
+
+  /** \brief measures a stage during its lifetime
+   */
+  class ScopedTimer : noncopyable
+  {
+  public:
+    explicit
+    ScopedTimer(ForwarderStage stage, ForwarderProfiler& profiler = ForwarderProfiler::get())
+      : m_profiler(profiler)
+      , m_stats(profiler.m_stats[static_cast<size_t>(stage)])
+      , m_parent(profiler.m_current)
+      , m_childTime(Clock::duration::zero())
+    {
+      ++m_stats.nCalls;
+      m_isSampled = m_parent != nullptr ?
+                    m_parent->m_isSampled :
+                    m_profiler.m_nOutermostCalls++ % m_profiler.m_samplingInterval == 0;
+      m_profiler.m_current = this;
+      if (m_isSampled) {
+        m_start = Clock::now();
+      }
+    }
+
+    ~ScopedTimer()
+    {
+      if (m_isSampled) {
+        Clock::duration elapsed = Clock::now() - m_start;
+        ++m_stats.nSampledCalls;
+        m_stats.sampledInclusiveTime += elapsed;
+        m_stats.sampledExclusiveTime += elapsed - m_childTime;
+        if (m_parent != nullptr) {
+          m_parent->m_childTime += elapsed;
+        }
+      }
+      m_profiler.m_current = m_parent;
+    }
+
+  private:
+    ForwarderProfiler& m_profiler;
+    StageStats& m_stats;
+    ScopedTimer* m_parent;
+    bool m_isSampled;
+    Clock::time_point m_start;
+    Clock::duration m_childTime;
+  };
+
+  ForwarderProfiler();
+
+  /** \return the profiler shared by all forwarders
+   */
+  static ForwarderProfiler&
+  get();
+
+  /** \brief set how often outermost stages are timed
+   *  \param interval 1 to time every call, N to time one in every N calls
+   */
+  void
+  setSamplingInterval(size_t interval);
+
+  size_t
+  getSamplingInterval() const
+  {
+    return m_samplingInterval;
+  }
+
+  const StageStats&
+  getStats(ForwarderStage stage) const
+  {
+    return m_stats[static_cast<size_t>(stage)];
+  }
+
+  /** \brief clear all statistics
+   *  \pre no stage is being measured
+   */
+  void
+  reset();
+
+  /** \brief print a table of the statistics of all called stages
+   */
+  void
+  print(std::ostream& os) const;
+
+private:
+  std::array<StageStats, N_FORWARDER_STAGES> m_stats;
+  size_t m_samplingInterval;
+  uint64_t m_nOutermostCalls;
+  ScopedTimer* m_current;
+};
+
+} // namespace fw
+} // namespace nfd
+
+/** \brief measure the rest of the enclosing scope as \p stage of ForwarderStage
+ *
+ *  Profiling is compiled in only if WITH_FORWARDER_PROFILING is defined, e.g., by
+ *  configuring with --enable-forwarder-profiling.
+ */
+#ifdef WITH_FORWARDER_PROFILING
+#define NFD_PROFILE_STAGE(stage) \
+  ::nfd::fw::ForwarderProfiler::ScopedTimer nfdProfiledStage(::nfd::fw::ForwarderStage::stage)
+#else
+#define NFD_PROFILE_STAGE(stage) do {} while (false)
+#endif // WITH_FORWARDER_PROFILING
+
+#endif // NFD_DAEMON_FW_FORWARDER_PROFILER_HPP
@@ -95,6 +95,8 @@ Forwarder::~Forwarder() = default;
 void
 Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& interest)
 {
+  NFD_PROFILE_STAGE(INCOMING_INTEREST);
+
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest in=" << ingress << " interest=" << interest.getProtocolString()
                                          << ": " << interest.getName());
@@ -136,7 +138,11 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
   }
 
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry;
+  {
+    NFD_PROFILE_STAGE(PIT_INSERT);
+    pitEntry = m_pit.insert(interest).first;
+  }
 
   // detect duplicate Nonce in PIT entry
   int dnw = fw::findDuplicateNonceWithProtocol(*pitEntry, interest.getNonce(), ingress.face,
@@ -162,6 +168,7 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
     if (id == "/976953572c8f4e8dbd433ff7be26db3c00000000") {
       std::cout << endl;
     }
+    NFD_PROFILE_STAGE(CS_LOOKUP);
     m_cs.find(interest, bind(&Forwarder::onContentStoreHit, this, ingress, pitEntry, _1, _2),
               bind(&Forwarder::onContentStoreMiss, this, ingress, pitEntry, _1));
   }
@@ -273,6 +280,8 @@ void
 Forwarder::onOutgoingInterest(const shared_ptr<pit::Entry>& pitEntry, const FaceEndpoint& egress,
                               const Interest& interest, bool isFirstNdn)
 {
+  NFD_PROFILE_STAGE(OUTGOING_INTEREST);
+
   NFD_LOG_DEBUG("onOutgoingInterest out=" << egress << " interest=" << pitEntry->getName());
 
   // insert out-record
@@ -321,6 +330,8 @@ Forwarder::onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry)
 void
 Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
 {
+  NFD_PROFILE_STAGE(INCOMING_DATA);
+
   // receive Data
   NFD_LOG_DEBUG("onIncomingData in=" << ingress << " data=" << data.getName());
   data.setTag(make_shared<lp::IncomingFaceIdTag>(ingress.face.getId()));
@@ -343,7 +354,11 @@ Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
   }
 
   // PIT match
-  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
+  pit::DataMatchResult pitMatches;
+  {
+    NFD_PROFILE_STAGE(FIND_ALL_DATA_MATCHES);
+    pitMatches = m_pit.findAllDataMatches(data);
+  }
   if (pitMatches.size() == 0) {
     // goto Data unsolicited pipeline
     this->onDataUnsolicited(ingress, data);
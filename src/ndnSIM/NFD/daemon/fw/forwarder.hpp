@@ -29,6 +29,7 @@
 #include "face-table.hpp"
 #include "face/face-endpoint.hpp"
 #include "forwarder-counters.hpp"
+#include "forwarder-profiler.hpp"
 #include "table/cs.hpp"
 #include "table/dead-nonce-list.hpp"
 #include "table/fib.hpp"
@@ -192,6 +193,22 @@ public:
    */
   signal::Signal<Forwarder, Interest> afterCsMiss;
 
+  /** \brief Signals when KoNDNStrategy starts an ID-space lookup for an Interest
+   *         that has no destination node ID yet
+   */
+  signal::Signal<Forwarder, Interest> afterKademliaLookupStart;
+
+  /** \brief Signals when KoNDNStrategy forwards an Interest toward the next node in ID space
+   *
+   *  The second argument is the ID of that node.
+   */
+  signal::Signal<Forwarder, Interest, Name> afterKademliaIdHop;
+
+  /** \brief Signals when KoNDNStrategy switches an Interest to NDN routing, which makes
+   *         this node the agent node of the Interest
+   */
+  signal::Signal<Forwarder, Interest> afterKademliaAgentSwitch;
+
   PUBLIC_WITH_TESTS_ELSE_PRIVATE
     : // pipelines
       /** \brief incoming Interest pipeline
@@ -254,6 +271,26 @@ public:
 
   VIRTUAL_WITH_TESTS void onNewNextHop(const Name& prefix, const fib::NextHop& nextHop);
 
+  /** \brief Kademlia tracing hooks, invoked by KoNDNStrategy
+   */
+  void
+  onKademliaLookupStart(const Interest& interest)
+  {
+    afterKademliaLookupStart(interest);
+  }
+
+  void
+  onKademliaIdHop(const Interest& interest, const Name& nextNodeId)
+  {
+    afterKademliaIdHop(interest, nextNodeId);
+  }
+
+  void
+  onKademliaAgentSwitch(const Interest& interest)
+  {
+    afterKademliaAgentSwitch(interest);
+  }
+
   PROTECTED_WITH_TESTS_ELSE_PRIVATE :
     /** \brief set a new expiry timer (now + \p duration) on a PIT entry
      */
@@ -278,6 +315,7 @@ public:
   dispatchToStrategy(pit::Entry& pitEntry, Function trigger)
 #endif
   {
+    NFD_PROFILE_STAGE(DISPATCH_TO_STRATEGY);
     trigger(m_strategyChoice.findEffectiveStrategy(pitEntry));
   }
 
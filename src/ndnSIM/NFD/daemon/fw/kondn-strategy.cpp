@@ -80,6 +80,10 @@ KoNDNStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest&
   Name interestDestID = interest.getDestinationNodeID();
 
   if (protocol.equals(Name("/kademlia"))) {
+    if (interestDestID.empty()) {
+      this->notifyKademliaLookupStart(interest);
+    }
+
     if (interestDestID.empty() || interestDestID.equals(getForwarder().getNodeId())) {
       std::vector<const nfd::fib::Entry*> fibEntries =
         this->lookupFibList(*pitEntry, this->getNodeID().toUri().substr(1));
@@ -113,6 +117,7 @@ KoNDNStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest&
             interest.setProtocol("ndn");
             interest.setDestinationNodeID(Name());
             interest.setAgentNodeID(this->getNodeID());
+            this->notifyKademliaAgentSwitch(interest);
             // PIT insert
             /*
             shared_ptr<pit::Entry> pitEntryNdn =
@@ -151,6 +156,7 @@ KoNDNStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest&
 
           auto egress = FaceEndpoint(it->getFace(), 0);
           interest.setDestinationNodeID(destinationName);
+          this->notifyKademliaIdHop(interest, destinationName);
           NFD_LOG_DEBUG(interest << " from=" << ingress << " newPitEntry-to=" << egress);
           this->sendInterest(pitEntry, egress, interest);
           return;
@@ -203,6 +209,7 @@ KoNDNStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest&
 
           interest.setProtocol("ndn");
           interest.setAgentNodeID(this->getNodeID());
+          this->notifyKademliaAgentSwitch(interest);
           // PIT insert
           /*
           shared_ptr<pit::Entry> pitEntryNdn =
@@ -295,6 +295,8 @@ Strategy::sendNacks(const shared_ptr<pit::Entry>& pitEntry, const lp::NackHeader
 const fib::Entry&
 Strategy::lookupFib(const pit::Entry& pitEntry) const
 {
+  NFD_PROFILE_STAGE(LOOKUP_FIB);
+
   const Fib& fib = m_forwarder.getFib();
 
   const Interest& interest = pitEntry.getInterest();
@@ -334,6 +336,8 @@ Strategy::lookupFib(const pit::Entry& pitEntry) const
 const fib::Entry&
 Strategy::lookupFib(const pit::Entry& pitEntry, std::string currentId) const
 {
+  NFD_PROFILE_STAGE(LOOKUP_FIB);
+
   const Fib& fib = m_forwarder.getFib();
 
   const Interest& interest = pitEntry.getInterest();
@@ -383,6 +387,8 @@ Strategy::lookupFib(const pit::Entry& pitEntry, std::string currentId) const
 const vector<const fib::Entry*>
 Strategy::lookupFibList(const pit::Entry& pitEntry, std::string currentId) const
 {
+  NFD_PROFILE_STAGE(LOOKUP_FIB_LIST);
+
   const Fib& fib = m_forwarder.getFib();
 
   const Interest& interest = pitEntry.getInterest();
@@ -319,6 +319,31 @@ protected: // actions
     m_forwarder.setExpiryTimer(pitEntry, duration);
   }
 
+protected: // Kademlia tracing hooks
+  /** \brief notify Forwarder::afterKademliaLookupStart subscribers
+   */
+  void
+  notifyKademliaLookupStart(const Interest& interest)
+  {
+    m_forwarder.onKademliaLookupStart(interest);
+  }
+
+  /** \brief notify Forwarder::afterKademliaIdHop subscribers
+   */
+  void
+  notifyKademliaIdHop(const Interest& interest, const Name& nextNodeId)
+  {
+    m_forwarder.onKademliaIdHop(interest, nextNodeId);
+  }
+
+  /** \brief notify Forwarder::afterKademliaAgentSwitch subscribers
+   */
+  void
+  notifyKademliaAgentSwitch(const Interest& interest)
+  {
+    m_forwarder.onKademliaAgentSwitch(interest);
+  }
+
 protected: // accessors
   /** \brief performs a FIB lookup, considering Link object if present
    */
@@ -68,6 +68,14 @@ public: // exposed through ContentStore enumeration
     return m_isUnsolicited;
   }
 
+  /** \brief return whether the stored Data has been cached on behalf of an agent node
+   */
+  bool
+  isAgent() const
+  {
+    return m_isAgent;
+  }
+
   /** \brief check if the stored Data is fresh now
    */
   bool
@@ -94,9 +102,18 @@ public: // used by ContentStore implementation
     m_isUnsolicited = false;
   }
 
+  /** \brief set 'agent' flag
+   */
+  void
+  setAgent()
+  {
+    m_isAgent = true;
+  }
+
 private:
   shared_ptr<const Data> m_data;
   bool m_isUnsolicited;
+  bool m_isAgent = false;
   time::steady_clock::TimePoint m_freshUntil;
 };
 
@@ -76,10 +76,21 @@ Cs::insert(const Data& data, bool isUnsolicited, bool isAgent)
     if (entry.isUnsolicited() && !isUnsolicited) {
       entry.clearUnsolicited();
     }
+    if (isAgent) {
+      entry.setAgent();
+    }
 
     m_policy->afterRefresh(it, isAgent);
   }
   else {
+    ++m_counters.nInserts;
+    if (isAgent) {
+      entry.setAgent();
+      ++m_counters.nAgentInserts;
+    }
+
+    m_exactIndex.emplace(std::hash<Name>()(data.getName()), it);
+    m_nDataBytes += data.wireEncode().size();
     m_policy->afterInsert(it, isAgent);
   }
 }
@@ -104,7 +115,7 @@ Cs::eraseImpl(const Name& prefix, size_t limit)
   size_t nErased = 0;
   while (i != last && nErased < limit) {
     m_policy->beforeErase(i);
-    i = m_table.erase(i);
+    this->eraseEntry(i++);
     ++nErased;
   }
   return nErased;
@@ -114,23 +125,79 @@ Cs::const_iterator
 Cs::findImpl(const Interest& interest) const
 {
   if (!m_shouldServe || m_policy->getLimit() == 0) {
+    ++m_counters.nMisses;
     return m_table.end();
   }
 
   const Name& prefix = interest.getName();
-  auto range = findPrefixRange(prefix);
-  auto match = std::find_if(range.first, range.second,
-                            [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+  const_iterator match = m_table.end();
+  if (!interest.getCanBePrefix() &&
+      (prefix.empty() || !prefix[-1].isImplicitSha256Digest())) {
+    match = this->findExactImpl(interest);
+  }
+  else {
+    auto range = findPrefixRange(prefix);
+    match = std::find_if(range.first, range.second,
+                         [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+    if (match == range.second) {
+      match = m_table.end();
+    }
+  }
 
-  if (match == range.second) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("find " << prefix << " no-match");
+    ++m_counters.nMisses;
     return m_table.end();
   }
   NFD_LOG_DEBUG("find " << prefix << " matching " << match->getName());
+  ++m_counters.nHits;
+  if (match->isAgent()) {
+    ++m_counters.nAgentHits;
+  }
   m_policy->beforeUse(match);
   return match;
 }
 
+Cs::const_iterator
+Cs::findExactImpl(const Interest& interest) const
+{
+  // among several satisfying entries (same name, different digests), prefer the first one
+  // in Table order, as the prefix range search would
+  const_iterator match = m_table.end();
+  auto range = m_exactIndex.equal_range(std::hash<Name>()(interest.getName()));
+  for (auto i = range.first; i != range.second; ++i) {
+    if (i->second->canSatisfy(interest) && (match == m_table.end() || i->second < match)) {
+      match = i->second;
+    }
+  }
+  return match;
+}
+
+void
+Cs::eraseEntry(const_iterator it)
+{
+  auto range = m_exactIndex.equal_range(std::hash<Name>()(it->getName()));
+  auto indexIt = std::find_if(range.first, range.second,
+                              [it] (const auto& indexEntry) { return indexEntry.second == it; });
+  BOOST_ASSERT(indexIt != range.second);
+  m_exactIndex.erase(indexIt);
+  m_nDataBytes -= it->getData().wireEncode().size();
+  m_table.erase(it);
+}
+
+size_t
+Cs::getMemoryUsage() const
+{
+  // a std::set node carries color and three links, an unordered_multimap node carries
+  // the next link and the cached hash, in addition to the stored value
+  static constexpr size_t TABLE_NODE_SIZE = sizeof(Entry) + 4 * sizeof(void*);
+  static constexpr size_t INDEX_NODE_SIZE = sizeof(decltype(m_exactIndex)::value_type) +
+                                            2 * sizeof(void*);
+
+  return m_table.size() * TABLE_NODE_SIZE + m_exactIndex.size() * INDEX_NODE_SIZE +
+         m_exactIndex.bucket_count() * sizeof(void*) + m_nDataBytes;
+}
+
 void
 Cs::dump()
 {
@@ -155,7 +222,13 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
 {
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { m_table.erase(it); });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) {
+    ++m_counters.nEvictions;
+    if (it->isAgent()) {
+      ++m_counters.nAgentEvictions;
+    }
+    this->eraseEntry(it);
+  });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
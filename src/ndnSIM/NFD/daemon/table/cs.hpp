@@ -27,6 +27,9 @@
 #define NFD_DAEMON_TABLE_CS_HPP
 
 #include "cs-policy.hpp"
+#include "common/counter.hpp"
+
+#include <unordered_map>
 
 namespace nfd {
 namespace cs {
@@ -38,6 +41,8 @@ namespace cs {
  *  The Table is a container ( \c std::set ) sorted by full Names of stored Data packets.
  *  Data packets are wrapped in Entry objects. Each Entry contains the Data packet itself,
  *  and a few additional attributes such as when the Data becomes non-fresh.
+ *  In addition, Table entries are indexed by the hash of their Data name, so that Interests
+ *  with CanBePrefix=false are served without searching the Table.
  *
  *  The replacement policy is implemented in a subclass of \c Policy.
  */
@@ -95,6 +100,14 @@ public:
     return m_table.size();
   }
 
+  /** \brief get estimated number of bytes allocated for stored packets, the Table and the
+   *         exact index
+   *
+   *  Replacement policy structures are not included.
+   */
+  size_t
+  getMemoryUsage() const;
+
 public: // configuration
   /** \brief get capacity (in number of packets)
    */
@@ -156,6 +169,33 @@ public: // configuration
   void
   enableServe(bool shouldServe);
 
+public: // statistics
+  /** \brief counters of Content Store operations
+   *
+   *  "Agent" counters cover the subset of operations on entries that have been cached on behalf
+   *  of an agent node.
+   */
+  struct Counters
+  {
+    /// number of lookups that found a match
+    PacketCounter nHits;
+    /// number of lookups that found no match
+    PacketCounter nMisses;
+    /// number of new entries
+    PacketCounter nInserts;
+    /// number of entries evicted by the replacement policy
+    PacketCounter nEvictions;
+    PacketCounter nAgentHits;
+    PacketCounter nAgentInserts;
+    PacketCounter nAgentEvictions;
+  };
+
+  const Counters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
 public: // enumeration
   using const_iterator = Table::const_iterator;
 
@@ -181,6 +221,17 @@ private:
   const_iterator
   findImpl(const Interest& interest) const;
 
+  /** \brief finds the first Table entry that satisfies \p interest, using the exact index
+   *  \pre interest.getCanBePrefix() == false, and its name does not end with implicit digest
+   */
+  const_iterator
+  findExactImpl(const Interest& interest) const;
+
+  /** \brief erases an entry from the Table and the exact index
+   */
+  void
+  eraseEntry(const_iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -190,11 +241,17 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  /** \brief Table entries by hash of Data name (without implicit digest)
+   */
+  std::unordered_multimap<size_t, const_iterator> m_exactIndex;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
   bool m_shouldAdmit = true; ///< if false, no Data will be admitted
   bool m_shouldServe = true; ///< if false, all lookups will miss
+
+  mutable Counters m_counters;
+  size_t m_nDataBytes = 0; ///< wire encoding bytes of stored packets
 };
 
 } // namespace cs
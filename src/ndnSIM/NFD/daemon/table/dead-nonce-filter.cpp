@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dead-nonce-filter.hpp"
+
+#include <cmath>
+
+namespace nfd {
+
+DeadNonceFilter::DeadNonceFilter(size_t capacity, double falsePositiveRate)
+  : m_capacity(capacity)
+{
+  if (capacity == 0) {
+    NDN_THROW(std::invalid_argument("capacity must be positive"));
+  }
+  if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+    NDN_THROW(std::invalid_argument("falsePositiveRate must be between 0 and 1"));
+  }
+
+  // start from the optimal size of a standard Bloom filter, then grow until the blocked filter
+  // meets the target, because uneven loads of blocks increase the false positive rate
+  double ln2 = std::log(2.0);
+  double nBits = -static_cast<double>(capacity) * std::log(falsePositiveRate) / (ln2 * ln2);
+  size_t nBlocks = std::max<size_t>(1, static_cast<size_t>(std::ceil(nBits / BLOCK_BITS)));
+  while (true) {
+    double entriesPerBlock = static_cast<double>(capacity) / nBlocks;
+    m_nHashes = 1;
+    for (unsigned int k = 2; k <= MAX_HASHES; ++k) {
+      if (computeFalsePositiveRate(entriesPerBlock, k) <
+          computeFalsePositiveRate(entriesPerBlock, m_nHashes)) {
+        m_nHashes = k;
+      }
+    }
+    if (computeFalsePositiveRate(entriesPerBlock, m_nHashes) <= falsePositiveRate) {
+      break;
+    }
+    nBlocks += std::max<size_t>(1, nBlocks / 16);
+  }
+  m_blocks.resize(nBlocks);
+
+  this->clear();
+}
+
+void
+DeadNonceFilter::add(uint64_t entry)
+{
+  FilterBlock& block = m_blocks[this->getBlockIndex(entry)];
+  uint64_t x = entry;
+  for (unsigned int i = 0; i < m_nHashes; ++i) {
+    size_t bit = nextBit(x);
+    block.words[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+  ++m_size;
+}
+
+bool
+DeadNonceFilter::has(uint64_t entry) const
+{
+  const FilterBlock& block = m_blocks[this->getBlockIndex(entry)];
+  uint64_t x = entry;
+  for (unsigned int i = 0; i < m_nHashes; ++i) {
+    size_t bit = nextBit(x);
+    if ((block.words[bit / 64] & (uint64_t(1) << (bit % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+DeadNonceFilter::clear()
+{
+  std::fill(m_blocks.begin(), m_blocks.end(), FilterBlock{});
+  m_size = 0;
+}
+
+double
+DeadNonceFilter::getFalsePositiveRate() const
+{
+  return computeFalsePositiveRate(static_cast<double>(m_size) / m_blocks.size(), m_nHashes);
+}
+
+double
+DeadNonceFilter::computeFalsePositiveRate(double entriesPerBlock, unsigned int nHashes)
+{
+  // the number of entries in a block follows a Poisson distribution
+  double rate = 0.0;
+  double probability = std::exp(-entriesPerBlock);
+  size_t last = static_cast<size_t>(entriesPerBlock + 10 * std::sqrt(entriesPerBlock) + 10);
+  for (size_t i = 0; i <= last; ++i) {
+    double fill = 1.0 - std::pow(1.0 - 1.0 / BLOCK_BITS, static_cast<double>(nHashes * i));
+    rate += probability * std::pow(fill, nHashes);
+    probability *= entriesPerBlock / (i + 1);
+  }
+  return rate;
+}
+
+} // namespace nfd
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+#define NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+
+/** \brief A blocked Bloom filter of Dead Nonce List entries
+ *
+ *  Each entry sets a few bits within one 512-bit block chosen by the entry hash,
+ *  so that insertion and lookup touch a single cache line.
+ *  The filter is sized for a given number of entries and a target false positive rate;
+ *  the actual false positive rate grows if more entries are added.
+ *
+ *  \sa DeadNonceList::enableFilter
+ */
+class DeadNonceFilter
+{
+public:
+  /** \param capacity expected number of entries
+   *  \param falsePositiveRate target false positive rate with \p capacity entries,
+   *         must be in (0, 1)
+   *  \throw std::invalid_argument invalid \p capacity or \p falsePositiveRate
+   */
+  DeadNonceFilter(size_t capacity, double falsePositiveRate);
+
+  void
+  add(uint64_t entry);
+
+  /** \return true if \p entry might have been added, false if it has definitely not been added
+   */
+  bool
+  has(uint64_t entry) const;
+
+  /** \brief removes all entries
+   */
+  void
+  clear();
+
+  /** \return number of add() calls since the last clear()
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /** \return estimated probability that has() returns true for an entry that has not been added
+   */
+  double
+  getFalsePositiveRate() const;
+
+  /** \return memory used by the filter, in bytes
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_blocks.size() * sizeof(FilterBlock);
+  }
+
+private:
+  static constexpr size_t BLOCK_WORDS = 8;
+  static constexpr size_t BLOCK_BITS = BLOCK_WORDS * 64;
+  static constexpr unsigned int MAX_HASHES = 16;
+
+  struct FilterBlock
+  {
+    uint64_t words[BLOCK_WORDS];
+  };
+
+  /** \return false positive rate of a filter with given average load per block
+   */
+  static double
+  computeFalsePositiveRate(double entriesPerBlock, unsigned int nHashes);
+
+  size_t
+  getBlockIndex(uint64_t entry) const
+  {
+    return ((entry >> 32) * m_blocks.size()) >> 32;
+  }
+
+  /** \brief advances \p state, and returns the next bit position within a block
+   */
+  static size_t
+  nextBit(uint64_t& state)
+  {
+    // multiplicative congruential steps; the top bits are well mixed and independent of
+    // the bits that selected the block
+    state = state * 0xd1342543de82ef95 + 0x9e3779b97f4a7c15;
+    return state >> (64 - 9);
+  }
+
+private:
+  std::vector<FilterBlock> m_blocks;
+  unsigned int m_nHashes;
+  size_t m_capacity;
+  size_t m_size = 0;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
@@ -68,6 +68,7 @@ DeadNonceList::~DeadNonceList()
 {
   m_markEvent.cancel();
   m_adjustCapacityEvent.cancel();
+  m_rotateFiltersEvent.cancel();
 
   BOOST_ASSERT_MSG(DEFAULT_LIFETIME >= MIN_LIFETIME, "DEFAULT_LIFETIME is too small");
   static_assert(INITIAL_CAPACITY >= MIN_CAPACITY, "INITIAL_CAPACITY is too small");
@@ -84,25 +85,103 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
+  if (this->isFilterEnabled()) {
+    return m_filters[0].size() + m_filters[1].size();
+  }
   return m_queue.size() - this->countMarks();
 }
 
+size_t
+DeadNonceList::getMemoryUsage() const
+{
+  if (this->isFilterEnabled()) {
+    return m_filters[0].getMemoryUsage() + m_filters[1].getMemoryUsage();
+  }
+
+  // an index node carries the links of the sequenced and the hashed index
+  static constexpr size_t NODE_SIZE = sizeof(Entry) + 4 * sizeof(void*);
+  return m_index.size() * NODE_SIZE + m_ht.bucket_count() * sizeof(void*);
+}
+
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  bool isFound = false;
+  if (this->isFilterEnabled()) {
+    m_counters.nExpectedFalsePositives += this->getFalsePositiveRate();
+    isFound = m_filters[0].has(entry) || m_filters[1].has(entry);
+  }
+  else {
+    isFound = m_ht.find(entry) != m_ht.end();
+  }
+
+  ++m_counters.nLookups;
+  if (isFound) {
+    ++m_counters.nHits;
+  }
+  return isFound;
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (this->isFilterEnabled()) {
+    if (m_filters[m_currentFilter].size() >= m_filters[m_currentFilter].getCapacity()) {
+      NFD_LOG_DEBUG("current filter is full, rotating before lifetime");
+      this->rotateFilters();
+    }
+    m_filters[m_currentFilter].add(entry);
+    return;
+  }
+
   m_queue.push_back(entry);
 
   this->evictEntries();
 }
 
+void
+DeadNonceList::enableFilter(size_t capacity, double falsePositiveRate)
+{
+  if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+    NDN_THROW(std::invalid_argument("falsePositiveRate must be between 0 and 1"));
+  }
+
+  // a lookup checks two filters, so each of them gets half of the false positive budget
+  std::vector<DeadNonceFilter> filters;
+  filters.emplace_back(capacity, falsePositiveRate / 2);
+  filters.emplace_back(capacity, falsePositiveRate / 2);
+  m_filters.swap(filters);
+  m_currentFilter = 0;
+  NFD_LOG_DEBUG("enableFilter capacity=" << capacity << " fpRate=" << falsePositiveRate
+                << " memory=" << 2 * m_filters.front().getMemoryUsage());
+
+  m_markEvent.cancel();
+  m_adjustCapacityEvent.cancel();
+  for (Entry entry : m_queue) {
+    if (entry != MARK) {
+      m_filters[m_currentFilter].add(entry);
+    }
+  }
+  m_index.clear();
+
+  m_rotateFiltersEvent = getScheduler().schedule(m_lifetime, [this] { rotateFilters(); });
+}
+
+double
+DeadNonceList::getFalsePositiveRate() const
+{
+  if (!this->isFilterEnabled()) {
+    // 64-bit hash collisions are negligible
+    return 0.0;
+  }
+  // same as 1 - (1 - rate0) * (1 - rate1), without losing small rates to the rounding of 1 - rate
+  double rate0 = m_filters[0].getFalsePositiveRate();
+  double rate1 = m_filters[1].getFalsePositiveRate();
+  return rate0 + rate1 - rate0 * rate1;
+}
+
 DeadNonceList::Entry
 DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
 {
@@ -164,4 +243,15 @@ DeadNonceList::evictEntries()
   BOOST_ASSERT(m_queue.size() >= m_capacity);
 }
 
+void
+DeadNonceList::rotateFilters()
+{
+  m_currentFilter = 1 - m_currentFilter;
+  m_filters[m_currentFilter].clear();
+  NFD_LOG_TRACE("rotateFilters current=" << m_currentFilter);
+
+  m_rotateFiltersEvent.cancel();
+  m_rotateFiltersEvent = getScheduler().schedule(m_lifetime, [this] { rotateFilters(); });
+}
+
 } // namespace nfd
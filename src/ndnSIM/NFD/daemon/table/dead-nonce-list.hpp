@@ -27,6 +27,8 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "core/common.hpp"
+#include "common/counter.hpp"
+#include "dead-nonce-filter.hpp"
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -50,6 +52,10 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  Alternatively, entries can be stored in a rotating pair of Bloom filters (see enableFilter).
+ *  Memory usage and per-operation cost are then fixed, at the expense of a configurable
+ *  false positive rate.
  */
 class DeadNonceList : noncopyable
 {
@@ -88,6 +94,12 @@ public:
   size_t
   size() const;
 
+  /** \return estimated number of bytes allocated for the index, or for the Bloom filters
+   *          if they are enabled
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \return expected lifetime
    */
   time::nanoseconds
@@ -96,6 +108,52 @@ public:
     return m_lifetime;
   }
 
+  /** \brief Switches storage to a rotating pair of Bloom filters
+   *  \param capacity expected number of Nonces added within lifetime
+   *  \param falsePositiveRate target probability that has() returns true for a name+nonce
+   *         that has not been added, when Nonces are added at the expected rate
+   *
+   *  New entries go into the current filter, and lookups check both filters. Every lifetime,
+   *  or earlier if \p capacity entries have been added to the current filter, the older filter
+   *  is cleared and becomes current. Thus an entry is kept for at least lifetime and less than
+   *  twice the lifetime, unless Nonces are added faster than \p capacity per lifetime.
+   *  Existing entries are moved into the filters. If the filters are already enabled, they are
+   *  replaced, and the entries they hold are lost.
+   *  \throw std::invalid_argument if \p capacity is zero, or \p falsePositiveRate is not
+   *         between 0 and 1; the list is left unchanged
+   */
+  void
+  enableFilter(size_t capacity, double falsePositiveRate);
+
+  bool
+  isFilterEnabled() const
+  {
+    return !m_filters.empty();
+  }
+
+  /** \return estimated probability that has() returns true for a name+nonce
+   *           that has not been added
+   */
+  double
+  getFalsePositiveRate() const;
+
+  struct Counters
+  {
+    /// number of has() calls
+    PacketCounter nLookups;
+    /// number of has() calls that returned true
+    PacketCounter nHits;
+    /// sum of getFalsePositiveRate() over all lookups; this is the expected number of
+    /// false positives if lookups are mostly for name+nonce that have not been added
+    double nExpectedFalsePositives = 0.0;
+  };
+
+  const Counters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
 private: // Entry and Index
   typedef uint64_t Entry;
 
@@ -139,6 +197,11 @@ private: // actual lifetime estimation and capacity control
   void
   evictEntries();
 
+  /** \brief Clear the older filter and make it current
+   */
+  void
+  rotateFilters();
+
 public:
   /// Default entry lifetime
   static const time::nanoseconds DEFAULT_LIFETIME;
@@ -211,6 +274,17 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
 
   /// Maximum number of entries to evict at each operation if index is over capacity
   static const size_t EVICT_LIMIT;
+
+  // ---- filter storage
+
+  /** \brief Bloom filters used instead of the index, if enabled
+   */
+  std::vector<DeadNonceFilter> m_filters;
+  size_t m_currentFilter = 0;
+  scheduler::EventId m_rotateFiltersEvent;
+
+private:
+  mutable Counters m_counters;
 };
 
 } // namespace nfd
@@ -45,6 +45,7 @@ nteHasFibEntry(const name_tree::Entry& nte)
 
 Fib::Fib(NameTree& nameTree)
   : m_nameTree(nameTree)
+  , m_nEntriesByLength(getMaxDepth() + 1)
 {
 }
 
@@ -89,7 +90,12 @@ Fib::findLongestIDMatchList(const Name& id, std::string currentNode) const
 const Entry&
 Fib::findLongestPrefixMatch(const Name& prefix) const
 {
-  return this->findLongestPrefixMatchImpl(prefix);
+  name_tree::Entry* nte = m_nameTree.findLongestPrefixMatch(prefix, m_prefixLengths,
+                                                            &nteHasFibEntry);
+  if (nte != nullptr) {
+    return *nte->getFibEntry();
+  }
+  return *s_emptyEntry;
 }
 
 const Entry&
@@ -107,7 +113,7 @@ Fib::findLongestPrefixMatch(const measurements::Entry& measurementsEntry) const
 Entry*
 Fib::findExactMatch(const Name& prefix)
 {
-  name_tree::Entry* nte = m_nameTree.findExactMatch(prefix);
+  name_tree::Entry* nte = m_nameTree.findExactMatch(prefix, getMaxDepth());
   if (nte != nullptr)
     return nte->getFibEntry();
 
@@ -117,7 +123,7 @@ Fib::findExactMatch(const Name& prefix)
 std::pair<Entry*, bool>
 Fib::insert(const Name& prefix)
 {
-  name_tree::Entry& nte = m_nameTree.lookup(prefix);
+  name_tree::Entry& nte = m_nameTree.lookup(prefix, std::min(prefix.size(), getMaxDepth()));
   Entry* entry = nte.getFibEntry();
   if (entry != nullptr) {
     return {entry, false};
@@ -126,6 +132,7 @@ Fib::insert(const Name& prefix)
   nte.setFibEntry(make_unique<Entry>(prefix));
   std::cout << "FIBI INS " << prefix.toUri() << std::endl;
   ++m_nItems;
+  this->updatePrefixLengths(nte.getName().size(), 1);
   return {nte.getFibEntry(), true};
 }
 
@@ -134,6 +141,10 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
 {
   BOOST_ASSERT(nte != nullptr);
 
+  if (nte->getFibEntry() != nullptr) {
+    this->updatePrefixLengths(nte->getName().size(), -1);
+    m_nNextHops -= nte->getFibEntry()->getNextHops().size();
+  }
   nte->setFibEntry(nullptr);
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
@@ -144,7 +155,7 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
 void
 Fib::erase(const Name& prefix)
 {
-  name_tree::Entry* nte = m_nameTree.findExactMatch(prefix);
+  name_tree::Entry* nte = m_nameTree.findExactMatch(prefix, getMaxDepth());
   if (nte != nullptr) {
     this->erase(nte);
   }
@@ -168,8 +179,10 @@ Fib::addOrUpdateNextHop(Entry& entry, Face& face, uint64_t cost)
   bool isNew;
   std::tie(it, isNew) = entry.addOrUpdateNextHop(face, cost);
 
-  if (isNew)
+  if (isNew) {
+    ++m_nNextHops;
     this->afterNewNextHop(entry.getPrefix(), *it);
+  }
 }
 
 Fib::RemoveNextHopResult
@@ -180,7 +193,9 @@ Fib::removeNextHop(Entry& entry, const Face& face)
   if (!isRemoved) {
     return RemoveNextHopResult::NO_SUCH_NEXTHOP;
   }
-  else if (!entry.hasNextHops()) {
+
+  --m_nNextHops;
+  if (!entry.hasNextHops()) {
     name_tree::Entry* nte = m_nameTree.getEntry(entry);
     this->erase(nte, false);
     return RemoveNextHopResult::FIB_ENTRY_REMOVED;
@@ -190,6 +205,22 @@ Fib::removeNextHop(Entry& entry, const Face& face)
   }
 }
 
+void
+Fib::updatePrefixLengths(size_t length, int delta)
+{
+  size_t& nEntries = m_nEntriesByLength.at(length);
+  nEntries += delta;
+
+  auto it = std::lower_bound(m_prefixLengths.begin(), m_prefixLengths.end(), length);
+  if (delta > 0 && nEntries == 1) {
+    m_prefixLengths.insert(it, length);
+  }
+  else if (delta < 0 && nEntries == 0) {
+    BOOST_ASSERT(it != m_prefixLengths.end() && *it == length);
+    m_prefixLengths.erase(it);
+  }
+}
+
 Fib::Range
 Fib::getRange() const
 {
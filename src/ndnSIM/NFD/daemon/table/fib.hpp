@@ -54,6 +54,14 @@ public:
     return m_nItems;
   }
 
+  /** \return estimated number of bytes allocated for entries and their nexthops
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_nItems * sizeof(Entry) + m_nNextHops * sizeof(NextHop);
+  }
+
 public:
   // lookup
 
@@ -96,9 +104,9 @@ public: // mutation
   }
 
   /** \brief Find or insert a FIB entry
-   *  \param prefix FIB entry name; it must not have more than \c getMaxDepth()
-   * components. \return the entry, and true for new entry or false for existing
-   * entry
+   *  \param prefix FIB entry name; if it has more than \c getMaxDepth() components,
+   * the entry is identified by the first \c getMaxDepth() of them. \return the entry,
+   * and true for new entry or false for existing entry
    */
   std::pair<Entry*, bool> insert(const Name& prefix);
 
@@ -161,11 +169,30 @@ private:
 
   void erase(name_tree::Entry* nte, bool canDeleteNte = true);
 
+  /** \brief update the set of FIB entry prefix lengths after an entry of \p length is
+   *         inserted (\p delta == 1) or erased (\p delta == -1)
+   */
+  void updatePrefixLengths(size_t length, int delta);
+
   Range getRange() const;
 
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  size_t m_nNextHops = 0;
+
+  /** \brief number of FIB entries by the length of their name tree entry's name
+   *
+   *  Prefixes longer than NameTree::getMaxDepth() are counted at that depth.
+   */
+  std::vector<size_t> m_nEntriesByLength;
+
+  /** \brief sorted prefix lengths that have at least one FIB entry
+   *
+   *  It allows findLongestPrefixMatch(const Name&) to binary-search on the prefix length
+   *  rather than probing the name tree on every length of the name.
+   */
+  std::vector<size_t> m_prefixLengths;
 
   /** \brief The empty FIB entry.
    *
@@ -107,7 +107,8 @@ Measurements::findLongestPrefixMatchImpl(const K& key, const EntryPredicate& pre
 Entry*
 Measurements::findLongestPrefixMatch(const Name& name, const EntryPredicate& pred) const
 {
-  return this->findLongestPrefixMatchImpl(name.getPrefix(NameTree::getMaxDepth()), pred);
+  // NameTree limits the depth, and the original name keeps its cached hashes usable
+  return this->findLongestPrefixMatchImpl(name, pred);
 }
 
 Entry*
@@ -151,6 +151,14 @@ public:
     return m_nItems;
   }
 
+  /** \return estimated number of bytes allocated for entries, excluding strategy information
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_nItems * sizeof(Entry);
+  }
+
 private:
   void
   cleanup(Entry& entry);
@@ -56,13 +56,38 @@ public:
  */
 using HashFunc = std::conditional<(sizeof(HashValue) > 4), Hash64, Hash32>::type;
 
+/** \return bytes of the wire buffer and the parsed components of an encoded name
+ */
+static size_t
+getNameBytes(const Name& name)
+{
+  return name.wireEncode().size() + name.size() * sizeof(Block);
+}
+
+/** \brief ensures that the first \p last components of \p name have wire encodings
+ *
+ *  Components of a decoded name, or created from URI or bytes, already have them, so the
+ *  name is encoded only when some component holds just its value.
+ */
+static void
+ensureComponentWires(const Name& name, size_t last)
+{
+  for (size_t i = 0; i < last; ++i) {
+    if (!name[i].hasWire()) {
+      name.wireEncode(); // re-parses all components from the new wire buffer
+      return;
+    }
+  }
+}
+
 HashValue
 computeHash(const Name& name, size_t prefixLen)
 {
-  name.wireEncode(); // ensure wire buffer exists
+  size_t last = std::min(prefixLen, name.size());
+  ensureComponentWires(name, last);
 
   HashValue h = 0;
-  for (size_t i = 0, last = std::min(prefixLen, name.size()); i < last; ++i) {
+  for (size_t i = 0; i < last; ++i) {
     const name::Component& comp = name[i];
     h ^= HashFunc::compute(comp.wire(), comp.size());
   }
@@ -72,10 +97,18 @@ computeHash(const Name& name, size_t prefixLen)
 HashSequence
 computeHashes(const Name& name, size_t prefixLen)
 {
-  name.wireEncode(); // ensure wire buffer exists
+  HashSequence seq;
+  computeHashes(name, prefixLen, seq);
+  return seq;
+}
 
+void
+computeHashes(const Name& name, size_t prefixLen, HashSequence& seq)
+{
   size_t last = std::min(prefixLen, name.size());
-  HashSequence seq;
+  ensureComponentWires(name, last);
+
+  seq.clear();
   seq.reserve(last + 1);
 
   HashValue h = 0;
@@ -86,27 +119,53 @@ computeHashes(const Name& name, size_t prefixLen)
     h ^= HashFunc::compute(comp.wire(), comp.size());
     seq.push_back(h);
   }
-  return seq;
 }
 
-Node::Node(HashValue h, const Name& name)
+Node::Node(HashValue h, const Name& name, uint32_t index)
   : hash(h)
-  , prev(nullptr)
-  , next(nullptr)
+  , index(index)
   , entry(name, this)
 {
 }
 
-Node::~Node()
+Node*
+getNode(const Entry& entry)
 {
-  BOOST_ASSERT(prev == nullptr);
-  BOOST_ASSERT(next == nullptr);
+  return entry.m_node;
+}
+
+NodePool::NodePool() = default;
+
+NodePool::~NodePool()
+{
+  BOOST_ASSERT(m_freeIndices.size() == m_nAllocated);
 }
 
 Node*
-getNode(const Entry& entry)
+NodePool::create(HashValue h, const Name& name)
 {
-  return entry.m_node;
+  uint32_t index = 0;
+  if (!m_freeIndices.empty()) {
+    index = m_freeIndices.back();
+    m_freeIndices.pop_back();
+  }
+  else {
+    index = m_nAllocated++;
+    if ((index >> CHUNK_BITS) == m_chunks.size()) {
+      m_chunks.emplace_back(new Storage[CHUNK_MASK + 1]);
+    }
+  }
+
+  return new (&m_chunks[index >> CHUNK_BITS][index & CHUNK_MASK]) Node(h, name, index);
+}
+
+void
+NodePool::destroy(Node* node)
+{
+  BOOST_ASSERT(node == this->get(node->index));
+  uint32_t index = node->index;
+  node->~Node();
+  m_freeIndices.push_back(index);
 }
 
 HashtableOptions::HashtableOptions(size_t size)
@@ -118,6 +177,7 @@ HashtableOptions::HashtableOptions(size_t size)
 Hashtable::Hashtable(const Options& options)
   : m_options(options)
   , m_size(0)
+  , m_nameBytes(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
   BOOST_ASSERT(m_options.initialSize >= m_options.minSize);
@@ -129,64 +189,60 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
-  m_buckets.resize(options.initialSize);
+  m_slots.resize(options.initialSize);
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
-  for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [](Node* node) {
-      node->prev = node->next = nullptr;
-      delete node;
-    });
+  for (Slot& slot : m_slots) {
+    if (!slot.isFree()) {
+      m_pool.destroy(m_pool.get(slot.index));
+      slot = Slot();
+    }
   }
 }
 
-void
-Hashtable::attach(size_t bucket, Node* node)
+size_t
+Hashtable::findBucket(const Node* node) const
 {
-  node->prev = nullptr;
-  node->next = m_buckets[bucket];
-
-  if (node->next != nullptr) {
-    BOOST_ASSERT(node->next->prev == nullptr);
-    node->next->prev = node;
+  size_t bucket = this->computeBucketIndex(node->hash);
+  while (m_slots[bucket].index != node->index) {
+    BOOST_ASSERT(!m_slots[bucket].isFree());
+    bucket = this->nextBucket(bucket);
   }
-
-  m_buckets[bucket] = node;
+  return bucket;
 }
 
 void
-Hashtable::detach(size_t bucket, Node* node)
+Hashtable::attach(const Node* node)
 {
-  if (node->prev != nullptr) {
-    BOOST_ASSERT(node->prev->next == node);
-    node->prev->next = node->next;
-  }
-  else {
-    BOOST_ASSERT(m_buckets[bucket] == node);
-    m_buckets[bucket] = node->next;
-  }
-
-  if (node->next != nullptr) {
-    BOOST_ASSERT(node->next->prev == node);
-    node->next->prev = node->prev;
+  size_t bucket = this->computeBucketIndex(node->hash);
+  while (!m_slots[bucket].isFree()) {
+    bucket = this->nextBucket(bucket);
   }
 
-  node->prev = node->next = nullptr;
+  m_slots[bucket].hashTag = static_cast<uint32_t>(node->hash);
+  m_slots[bucket].index = node->index;
 }
 
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
   size_t bucket = this->computeBucketIndex(h);
-
-  for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
-    if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
-      NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
-      return {node, false};
+  uint32_t hashTag = static_cast<uint32_t>(h);
+
+  // the probe sequence ends at a free slot, or after visiting every slot of a full table
+  for (size_t nProbes = 0; nProbes < m_slots.size() && !m_slots[bucket].isFree(); ++nProbes) {
+    const Slot& slot = m_slots[bucket];
+    if (slot.hashTag == hashTag) {
+      const Node* node = m_pool.get(slot.index);
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
+        return {node, false};
+      }
     }
+    bucket = this->nextBucket(bucket);
   }
 
   if (!allowInsert) {
@@ -195,10 +251,21 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
     return {nullptr, false};
   }
 
-  Node* node = new Node(h, name.getPrefix(prefixLen));
-  this->attach(bucket, node);
-  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
+  if (m_size == this->getNBuckets()) {
+    this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
+  }
+
+  // encode the prefix into its own buffer, so that the entry doesn't retain the packet
+  // from which the name was taken
+  Name prefix = name.getPrefix(prefixLen);
+  prefix.wireEncode();
+
+  Node* node = m_pool.create(h, prefix);
+  this->attach(node);
+  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h
+                          << " bucket=" << this->computeBucketIndex(h));
   ++m_size;
+  m_nameBytes += getNameBytes(node->entry.getName());
 
   if (m_size > m_expandThreshold) {
     this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
@@ -243,11 +310,11 @@ Hashtable::findOrInsertByID(const Name& contentName, HashValue h, std::string cu
 
   nextHopList.push_back({tmp, 0});
 
-  for (auto it = m_buckets.begin(), e = m_buckets.end(); it != e; ++it) {
-    const Node* node = *it;
-    if (node == nullptr) {
+  for (const Slot& slot : m_slots) {
+    if (slot.isFree()) {
       continue;
     }
+    const Node* node = m_pool.get(slot.index);
 
     std::string nodeIdString = node->entry.getName().toUri().substr(1);
     if (!nodeIdString.size() || nodeIdString.size() != 40) {
@@ -265,7 +332,6 @@ Hashtable::findOrInsertByID(const Name& contentName, HashValue h, std::string cu
   sort(nextHopList.begin(), nextHopList.end(), cmpXor());
 
   const Node* returnNode = nextHopList.front().second;
-  // const Node* node = m_buckets[bucket];
 
   if (returnNode) {
     return {returnNode, false};
@@ -302,11 +368,11 @@ Hashtable::findOrInsertByIDList(const Name& contentName, HashValue h, std::strin
 
   nextHopList.push_back({tmp, 0});
 
-  for (auto it = m_buckets.begin(), e = m_buckets.end(); it != e; ++it) {
-    const Node* node = *it;
-    if (node == nullptr) {
+  for (const Slot& slot : m_slots) {
+    if (slot.isFree()) {
       continue;
     }
+    const Node* node = m_pool.get(slot.index);
 
     std::string nodeIdString = node->entry.getName().toUri().substr(1);
     if (!nodeIdString.size() || nodeIdString.size() != 40) {
@@ -323,7 +389,6 @@ Hashtable::findOrInsertByIDList(const Name& contentName, HashValue h, std::strin
 
   sort(nextHopList.begin(), nextHopList.end(), cmpXor());
 
-  // const Node* node = m_buckets[bucket];
 
   std::vector<const Node*> retList;
 
@@ -384,14 +449,28 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
-  size_t bucket = this->computeBucketIndex(node->hash);
+  size_t hole = this->findBucket(node);
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash
-                         << " bucket=" << bucket);
+                         << " bucket=" << hole);
 
-  this->detach(bucket, node);
-  delete node;
+  m_slots[hole] = Slot();
+  m_nameBytes -= getNameBytes(node->entry.getName());
+  m_pool.destroy(node);
   --m_size;
 
+  // backward shift deletion keeps probe sequences of the remaining nodes intact
+  for (size_t bucket = this->nextBucket(hole); !m_slots[bucket].isFree();
+       bucket = this->nextBucket(bucket)) {
+    size_t home = this->computeBucketIndex(m_pool.get(m_slots[bucket].index)->hash);
+    bool isInPlace = hole <= bucket ? (hole < home && home <= bucket)
+                                    : (hole < home || home <= bucket);
+    if (!isInPlace) {
+      m_slots[hole] = m_slots[bucket];
+      m_slots[bucket] = Slot();
+      hole = bucket;
+    }
+  }
+
   if (m_size < m_shrinkThreshold) {
     size_t newNBuckets = std::max(m_options.minSize, static_cast<size_t>(m_options.shrinkFactor
                                                                          * this->getNBuckets()));
@@ -415,15 +494,16 @@ Hashtable::resize(size_t newNBuckets)
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
-  std::vector<Node*> oldBuckets;
-  oldBuckets.swap(m_buckets);
-  m_buckets.resize(newNBuckets);
+  // a table cannot hold more nodes than it has slots
+  newNBuckets = std::max(newNBuckets, m_size);
+
+  std::vector<Slot> oldSlots(newNBuckets);
+  oldSlots.swap(m_slots);
 
-  for (Node* head : oldBuckets) {
-    foreachNode(head, [this](Node* node) {
-      size_t bucket = this->computeBucketIndex(node->hash);
-      this->attach(bucket, node);
-    });
+  for (const Slot& slot : oldSlots) {
+    if (!slot.isFree()) {
+      this->attach(m_pool.get(slot.index));
+    }
   }
 
   this->computeThresholds();
@@ -51,27 +51,27 @@ HashValue computeHash(const Name& name, size_t prefixLen = std::numeric_limits<s
  */
 HashSequence computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
+/** \brief computes hash values for each prefix of \p name.getPrefix(prefixLen) into \p seq
+ *
+ *  Unlike the other overload, this reuses the storage of \p seq.
+ */
+void computeHashes(const Name& name, size_t prefixLen, HashSequence& seq);
+
 /** \brief a hashtable node
  *
- *  Zero or more nodes can be added to a hashtable bucket. They are organized as
- *  a doubly linked list through prev and next pointers.
+ *  Nodes are allocated from a NodePool owned by the hashtable, and are referenced from
+ *  hashtable slots by their index in the pool.
  */
 class Node : noncopyable {
 public:
   /** \post entry.getName() == name
    *  \post getNode(entry) == this
    */
-  Node(HashValue h, const Name& name);
-
-  /** \pre prev == nullptr
-   *  \pre next == nullptr
-   */
-  ~Node();
+  Node(HashValue h, const Name& name, uint32_t index);
 
 public:
   const HashValue hash;
-  Node* prev;
-  Node* next;
+  const uint32_t index; ///< index of the node in its NodePool
   mutable Entry entry;
 };
 
@@ -80,22 +80,49 @@ public:
  */
 Node* getNode(const Entry& entry);
 
-/** \brief invoke a function for each node in a doubly linked list
- *  \tparam N either Node or const Node
- *  \tparam F a functor with signature void F(N*)
- *  \note It's safe to delete the node in the function.
+/** \brief an arena of Node objects
+ *
+ *  Nodes are constructed in fixed-size chunks and identified by a 32-bit index, so that
+ *  hashtable slots can refer to them compactly.  Storage of destroyed nodes is reused.
  */
-template <typename N, typename F>
-void
-foreachNode(N* head, const F& func)
-{
-  N* node = head;
-  while (node != nullptr) {
-    N* next = node->next;
-    func(node);
-    node = next;
+class NodePool : noncopyable {
+public:
+  NodePool();
+
+  /** \pre all nodes have been destroyed
+   */
+  ~NodePool();
+
+  Node*
+  create(HashValue h, const Name& name);
+
+  void
+  destroy(Node* node);
+
+  Node*
+  get(uint32_t index) const
+  {
+    return reinterpret_cast<Node*>(&m_chunks[index >> CHUNK_BITS][index & CHUNK_MASK]);
+  }
+
+  /** \return number of nodes that fit into the allocated chunks
+   */
+  size_t
+  getCapacity() const
+  {
+    return m_chunks.size() << CHUNK_BITS;
   }
-}
+
+private:
+  static constexpr uint32_t CHUNK_BITS = 5;
+  static constexpr uint32_t CHUNK_MASK = (1 << CHUNK_BITS) - 1;
+
+  using Storage = typename std::aligned_storage<sizeof(Node), alignof(Node)>::type;
+
+  std::vector<unique_ptr<Storage[]>> m_chunks;
+  std::vector<uint32_t> m_freeIndices;
+  uint32_t m_nAllocated = 0;
+};
 
 /** \brief provides options for Hashtable
  */
@@ -135,9 +162,11 @@ public:
 
 /** \brief a hashtable for fast exact name lookup
  *
- *  The Hashtable contains a number of buckets.
- *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  The Hashtable contains a number of buckets (slots), each holding at most one node.
+ *  A node is placed into the first free slot at or after the bucket determined by the hash
+ *  value computed from its name (open addressing with linear probing).  Each slot stores
+ *  the low bits of the hash and the pool index of the node, so that probing rarely needs
+ *  to touch the nodes themselves.
  *  The number of buckets is adjusted according to how many nodes are stored.
  */
 class Hashtable {
@@ -163,10 +192,20 @@ public:
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_slots.size();
   }
 
-  /** \return bucket index for hash value h
+  /** \return estimated number of bytes allocated for slots, nodes and their names
+   *
+   *  Table entries attached to the nodes are not included.
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_slots.capacity() * sizeof(Slot) + m_pool.getCapacity() * sizeof(Node) + m_nameBytes;
+  }
+
+  /** \return bucket index for hash value h, where the probing for h starts
    */
   size_t
   computeBucketIndex(HashValue h) const
@@ -174,16 +213,23 @@ public:
     return h % this->getNBuckets();
   }
 
-  /** \return i-th bucket
+  /** \return node in i-th bucket, or nullptr if the bucket is free
    *  \pre bucket < getNBuckets()
    */
   const Node*
   getBucket(size_t bucket) const
   {
     BOOST_ASSERT(bucket < this->getNBuckets());
-    return m_buckets[bucket]; // don't use m_bucket.at() for better performance
+    const Slot& slot = m_slots[bucket]; // don't use m_slots.at() for better performance
+    return slot.isFree() ? nullptr : m_pool.get(slot.index);
   }
 
+  /** \return bucket that holds \p node
+   *  \pre node exists in this hashtable
+   */
+  size_t
+  findBucket(const Node* node) const;
+
   /** \brief find node for ID
    *  \pre name
    */
@@ -218,20 +264,38 @@ public:
   void erase(Node* node);
 
 private:
-  /** \brief attach node to bucket
-   */
-  void attach(size_t bucket, Node* node);
+  struct Slot {
+    static constexpr uint32_t FREE = std::numeric_limits<uint32_t>::max();
+
+    bool
+    isFree() const
+    {
+      return index == FREE;
+    }
+
+    uint32_t hashTag = 0;  ///< low bits of the node's hash value
+    uint32_t index = FREE; ///< index of the node in m_pool
+  };
+
+  size_t
+  nextBucket(size_t bucket) const
+  {
+    return bucket + 1 == this->getNBuckets() ? 0 : bucket + 1;
+  }
 
-  /** \brief detach node from bucket
+  /** \brief place node into the first free slot of its probe sequence
    */
-  void detach(size_t bucket, Node* node);
+  void attach(const Node* node);
 
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
+
   std::pair<const Node*, bool>
   findOrInsertByID(const Name& name, HashValue h, std::string currentId, bool allowInsert);
+
   std::pair<const std::vector<const Node*>, bool>
   findOrInsertByIDList(const Name& name, HashValue h, std::string currentId, bool allowInsert);
+
   struct cmpXor;
 
   void computeThresholds();
@@ -239,9 +303,11 @@ private:
   void resize(size_t newNBuckets);
 
 private:
-  std::vector<Node*> m_buckets;
+  std::vector<Slot> m_slots;
+  NodePool m_pool;
   Options m_options;
   size_t m_size;
+  size_t m_nameBytes; ///< TLV and component index bytes of all node names
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
 };
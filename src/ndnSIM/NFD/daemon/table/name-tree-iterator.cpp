@@ -132,25 +132,16 @@ FullEnumerationImpl::advance(Iterator& i)
     }
   }
 
-  // process entries in same bucket
-  for (const Node* node = getNode(*i.m_entry)->next; node != nullptr; node = node->next) {
-    if (m_pred(node->entry)) {
+  // process following buckets
+  size_t currentBucket = ht.findBucket(getNode(*i.m_entry));
+  for (size_t bucket = currentBucket + 1; bucket < ht.getNBuckets(); ++bucket) {
+    const Node* node = ht.getBucket(bucket);
+    if (node != nullptr && m_pred(node->entry)) {
       i.m_entry = &node->entry;
       return;
     }
   }
 
-  // process other buckets
-  size_t currentBucket = ht.computeBucketIndex(getNode(*i.m_entry)->hash);
-  for (size_t bucket = currentBucket + 1; bucket < ht.getNBuckets(); ++bucket) {
-    for (const Node* node = ht.getBucket(bucket); node != nullptr; node = node->next) {
-      if (m_pred(node->entry)) {
-        i.m_entry = &node->entry;
-        return;
-      }
-    }
-  }
-
   // reach the end
   i = Iterator();
 }
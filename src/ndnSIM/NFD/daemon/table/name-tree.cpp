@@ -48,7 +48,7 @@ NameTree::lookup(const Name& name, size_t prefixLen)
   BOOST_ASSERT(prefixLen <= name.size());
   BOOST_ASSERT(prefixLen <= getMaxDepth());
 
-  HashSequence hashes = computeHashes(name, prefixLen);
+  const HashSequence& hashes = this->getHashes(name);
   const Node* node = nullptr;
   Entry* parent = nullptr;
 
@@ -155,7 +155,7 @@ NameTree::findExactMatch(const Name& name, size_t prefixLen) const
     return nullptr;
   }
 
-  const Node* node = m_ht.find(name, prefixLen);
+  const Node* node = m_ht.find(name, prefixLen, this->getHashes(name));
   return node == nullptr ? nullptr : &node->entry;
 }
 
@@ -208,7 +208,7 @@ Entry*
 NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector) const
 {
   size_t depth = std::min(name.size(), getMaxDepth());
-  HashSequence hashes = computeHashes(name, depth);
+  const HashSequence& hashes = this->getHashes(name);
 
   for (ssize_t i = depth; i >= 0; --i) {
     const Node* node = m_ht.find(name, i, hashes);
@@ -220,6 +220,38 @@ NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySel
   return nullptr;
 }
 
+Entry*
+NameTree::findLongestPrefixMatch(const Name& name, const std::vector<size_t>& prefixLengths,
+                                 const EntrySelector& entrySelector) const
+{
+  BOOST_ASSERT(std::is_sorted(prefixLengths.begin(), prefixLengths.end()));
+  size_t depth = std::min(name.size(), getMaxDepth());
+  const HashSequence& hashes = this->getHashes(name);
+
+  // find the longest candidate length where an entry exists; entries exist on every length
+  // up to that one, and on no length beyond it
+  const Node* deepest = nullptr;
+  auto first = prefixLengths.begin();
+  auto last = std::upper_bound(first, prefixLengths.end(), depth);
+  while (first < last) {
+    auto mid = first + (last - first) / 2;
+    const Node* node = m_ht.find(name, *mid, hashes);
+    if (node != nullptr) {
+      deepest = node;
+      first = mid + 1;
+    }
+    else {
+      last = mid;
+    }
+  }
+
+  if (deepest == nullptr) {
+    return nullptr;
+  }
+  // the deepest entry may be a marker of a longer name, so continue with its ancestors
+  return this->findLongestPrefixMatch(deepest->entry, entrySelector);
+}
+
 Entry*
 NameTree::findLongestPrefixMatch(const Entry& entry1, const EntrySelector& entrySelector) const
 {
@@ -285,5 +317,30 @@ NameTree::partialEnumerate(const Name& prefix,
   return {Iterator(make_shared<PartialEnumerationImpl>(*this, entrySubTreeSelector), entry), end()};
 }
 
+const HashSequence&
+NameTree::getHashes(const Name& name) const
+{
+  if (!name.hasWire()) {
+    // a name built by the forwarder is not worth encoding just to be recognized later
+    m_hashedBuffer.reset();
+    m_hashedWire = nullptr;
+    m_hashedWireSize = 0;
+    computeHashes(name, getMaxDepth(), m_hashes);
+    return m_hashes;
+  }
+
+  const Block& wire = name.wireEncode(); // existing encoding, nothing is allocated
+  if (wire.wire() == m_hashedWire && wire.size() == m_hashedWireSize &&
+      wire.getBuffer() == m_hashedBuffer) {
+    return m_hashes;
+  }
+
+  computeHashes(name, getMaxDepth(), m_hashes);
+  m_hashedBuffer = wire.getBuffer();
+  m_hashedWire = wire.wire();
+  m_hashedWireSize = wire.size();
+  return m_hashes;
+}
+
 } // namespace name_tree
 } // namespace nfd
@@ -69,6 +69,15 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \return estimated number of bytes allocated for name tree entries and the hashtable,
+   *          excluding table entries attached to them
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_ht.getMemoryUsage();
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -177,6 +186,18 @@ public: // matching
   Entry*
   findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Longest prefix matching restricted to entries with given name lengths
+   *  \param prefixLengths sorted lengths of all names whose entries can pass \p entrySelector
+   *
+   *  Because every ancestor of an entry also exists in the name tree, the entries on lengths in
+   *  \p prefixLengths act as markers for a binary search on the prefix length, which takes
+   *  O(log(prefixLengths.size())) hashtable lookups. The result is the same as
+   *  `findLongestPrefixMatch(name, entrySelector)`.
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const std::vector<size_t>& prefixLengths,
+                         const EntrySelector& entrySelector) const;
+
   /** \brief Equivalent to `findLongestPrefixMatch(entry.getName(),
    * entrySelector)` \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in
@@ -293,9 +314,25 @@ public: // enumeration
     return Iterator();
   }
 
+private:
+  /** \return hash sequence of \p name.getPrefix(getMaxDepth())
+   *
+   *  A packet is usually looked up in several tables sharing this name tree (PIT, FIB,
+   *  Measurements, StrategyChoice), so the sequence of the most recently hashed name is cached.
+   *  Names are recognized by the identity of their wire encoding, names without one are
+   *  hashed from their components and not cached.
+   */
+  const HashSequence&
+  getHashes(const Name& name) const;
+
 private:
   Hashtable m_ht;
 
+  mutable ndn::ConstBufferPtr m_hashedBuffer; ///< keeps wire of the hashed name immutable
+  mutable const uint8_t* m_hashedWire = nullptr;
+  mutable size_t m_hashedWireSize = 0;
+  mutable HashSequence m_hashes;
+
   friend class EnumerationImpl;
 };
 
@@ -25,13 +25,31 @@
 
 #include "pit-entry.hpp"
 
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
 #include <algorithm>
 
 namespace nfd {
 namespace pit {
 
+/** \return size of the encoding of \p interest
+ *  \note An Interest from a local application may have no encoding yet. Its size is estimated
+ *        without caching an encoding, which would otherwise be reported by byte counters.
+ */
+static size_t
+getEncodedSize(const Interest& interest)
+{
+  if (interest.hasWire()) {
+    return interest.wireEncode().size();
+  }
+
+  ndn::EncodingEstimator estimator;
+  return interest.wireEncode(estimator);
+}
+
 Entry::Entry(const Interest& interest)
   : m_interest(interest.shared_from_this())
+  , m_interestSize(getEncodedSize(interest))
 {
 }
 
@@ -66,8 +84,7 @@ Entry::insertOrUpdateInRecord(Face& face, const Interest& interest)
     return &inRecord.getFace() == &face;
   });
   if (it == m_inRecords.end()) {
-    m_inRecords.emplace_front(face);
-    it = m_inRecords.begin();
+    it = m_inRecords.emplace(m_inRecords.begin(), face);
   }
 
   it->update(interest);
@@ -109,8 +126,7 @@ Entry::insertOrUpdateOutRecord(Face& face, const Interest& interest, bool firstN
     std::find_if(m_outRecords.begin(), m_outRecords.end(),
                  [&face](const OutRecord& outRecord) { return &outRecord.getFace() == &face; });
   if (it == m_outRecords.end()) {
-    m_outRecords.emplace_front(face);
-    it = m_outRecords.begin();
+    it = m_outRecords.emplace(m_outRecords.begin(), face);
   }
 
   it->update(interest);
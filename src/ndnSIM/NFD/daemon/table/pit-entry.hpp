@@ -29,7 +29,7 @@
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
 
-#include <list>
+#include <boost/container/small_vector.hpp>
 
 namespace nfd {
 
@@ -40,12 +40,18 @@ class Entry;
 namespace pit {
 
 /** \brief An unordered collection of in-records
+ *
+ *  The first few records are stored inside the PIT entry.
+ *  \warning Inserting or deleting a record invalidates iterators and references to records.
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef boost::container::small_vector<InRecord, 2> InRecordCollection;
 
 /** \brief An unordered collection of out-records
+ *
+ *  The first few records are stored inside the PIT entry.
+ *  \warning Inserting or deleting a record invalidates iterators and references to records.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef boost::container::small_vector<OutRecord, 2> OutRecordCollection;
 
 /** \brief An Interest table entry
  *
@@ -78,6 +84,16 @@ public:
     return m_interest->getName();
   }
 
+  /** \return size of the representative Interest encoding when the entry was created
+   *  \note The representative Interest can be modified in place by a strategy (e.g., its
+   *        Protocol or DestinationNodeID), so its current encoding may have another size.
+   */
+  size_t
+  getInterestSize() const
+  {
+    return m_interestSize;
+  }
+
   /** \return whether interest matches this entry
    *  \param interest the Interest
    *  \param nEqualNameComps number of initial name components guaranteed to be equal
@@ -239,6 +255,7 @@ public:
 
 private:
   shared_ptr<const Interest> m_interest;
+  size_t m_interestSize;
   InRecordCollection m_inRecords;
   OutRecordCollection m_outRecords;
 
@@ -25,9 +25,13 @@
 
 #include "pit-face-record.hpp"
 
+#include <unordered_set>
+
 namespace nfd {
 namespace pit {
 
+const Name FaceRecord::s_noProtocol;
+
 void
 FaceRecord::update(const Interest& interest)
 {
@@ -38,9 +42,19 @@ FaceRecord::update(const Interest& interest)
   if (lifetime < 0_ms) {
     lifetime = ndn::DEFAULT_INTEREST_LIFETIME;
   }
-  m_protocol = interest.getProtocol();
+  if (*m_protocol != interest.getProtocol()) {
+    m_protocol = &internProtocol(interest.getProtocol());
+  }
   m_expiry = m_lastRenewed + lifetime;
 }
 
+const Name&
+FaceRecord::internProtocol(const Name& protocol)
+{
+  // elements of an unordered_set are never moved, and are kept until the program exits
+  static std::unordered_set<Name> protocols;
+  return *protocols.insert(protocol).first;
+}
+
 } // namespace pit
 } // namespace nfd
@@ -35,20 +35,23 @@ namespace pit {
 /** \brief Contains information about an Interest on an incoming or outgoing face
  *  \note This is an implementation detail to extract common functionality
  *        of InRecord and OutRecord
+ *
+ *  Records are stored by value in small vectors of the PIT entry, so they must be cheap to
+ *  move, and they keep only the fields of the Interest needed by the forwarding pipelines.
  */
 class FaceRecord : public StrategyInfoHost
 {
 public:
   explicit
   FaceRecord(Face& face)
-    : m_face(face)
+    : m_face(&face)
   {
   }
 
   Face&
   getFace() const
   {
-    return m_face;
+    return *m_face;
   }
 
   uint32_t
@@ -58,9 +61,9 @@ public:
   }
 
   const Name&
-  getProtocol()  const noexcept
+  getProtocol() const noexcept
   {
-    return m_protocol;
+    return *m_protocol;
   }
 
   time::steady_clock::TimePoint
@@ -84,11 +87,22 @@ public:
   update(const Interest& interest);
 
 private:
-  Face& m_face;
+  /** \return a long-lived Name equal to \p protocol
+   *
+   *  Interests carry one of very few protocol names, so records refer to a shared copy
+   *  instead of holding their own.
+   */
+  static const Name&
+  internProtocol(const Name& protocol);
+
+  static const Name s_noProtocol;
+
+private:
+  Face* m_face;
   uint32_t m_lastNonce = 0;
   time::steady_clock::TimePoint m_lastRenewed = time::steady_clock::TimePoint::min();
   time::steady_clock::TimePoint m_expiry = time::steady_clock::TimePoint::min();
-  mutable Name m_protocol;
+  const Name* m_protocol = &s_noProtocol;
 };
 
 } // namespace pit
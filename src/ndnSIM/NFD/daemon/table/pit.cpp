@@ -80,6 +80,7 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   auto entry = make_shared<Entry>(interest);
   nte->insertPitEntry(entry);
   ++m_nItems;
+  m_nInterestBytes += entry->getInterestSize();
   return {entry, true};
 }
 
@@ -105,6 +106,7 @@ Pit::erase(Entry* entry, bool canDeleteNte)
   name_tree::Entry* nte = m_nameTree.getEntry(*entry);
   BOOST_ASSERT(nte != nullptr);
 
+  m_nInterestBytes -= entry->getInterestSize();
   nte->erasePitEntry(entry);
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
@@ -58,6 +58,16 @@ public:
     return m_nItems;
   }
 
+  /** \return estimated number of bytes allocated for entries and their Interests
+   *
+   *  In-records, out-records and strategy information are not included.
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return m_nItems * sizeof(Entry) + m_nInterestBytes;
+  }
+
   /** \brief Finds a PIT entry for \p interest
    *  \param interest the Interest
    *  \return an existing entry with same Name and Selectors; otherwise nullptr
@@ -136,6 +146,7 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  size_t m_nInterestBytes = 0;
 };
 
 } // namespace pit
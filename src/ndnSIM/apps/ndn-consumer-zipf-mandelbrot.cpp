@@ -23,6 +23,8 @@
 
 #include <math.h>
 
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
 namespace ns3 {
@@ -32,6 +34,9 @@ typedef boost::array<boost::uint8_t, 20> hash_data_t;
 
 NS_OBJECT_ENSURE_REGISTERED(ConsumerZipfMandelbrot);
 
+std::map<ConsumerZipfMandelbrot::Parameters, weak_ptr<const std::vector<double>>>
+  ConsumerZipfMandelbrot::s_distributions;
+
 TypeId
 ConsumerZipfMandelbrot::GetTypeId(void)
 {
@@ -72,24 +77,55 @@ ConsumerZipfMandelbrot::~ConsumerZipfMandelbrot()
 {
 }
 
-void
-ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
+const std::vector<double>&
+ConsumerZipfMandelbrot::GetCumulativeProbabilities()
 {
-  m_N = numOfContents;
+  if (m_Pcum != nullptr) {
+    return *m_Pcum;
+  }
+
+  Parameters parameters(m_N, m_q, m_s);
+  m_Pcum = s_distributions[parameters].lock();
+  if (m_Pcum != nullptr) {
+    NS_LOG_DEBUG("Reusing distribution for " << m_q << " and " << m_s << " and " << m_N);
+    return *m_Pcum;
+  }
 
   NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double>(m_N + 1);
+  auto pcum = make_shared<std::vector<double>>(m_N + 1);
+  std::vector<double>& Pcum = *pcum;
 
-  m_Pcum[0] = 0.0;
+  Pcum[0] = 0.0;
   for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
+    Pcum[i] = Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
   }
 
   for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+    Pcum[i] = Pcum[i] / Pcum[m_N];
+    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << Pcum[i]);
+  }
+
+  // drop entries of distributions that are no longer used by any consumer
+  for (auto it = s_distributions.begin(); it != s_distributions.end();) {
+    if (it->second.expired()) {
+      it = s_distributions.erase(it);
+    }
+    else {
+      ++it;
+    }
   }
+
+  m_Pcum = pcum;
+  s_distributions[parameters] = m_Pcum;
+  return *m_Pcum;
+}
+
+void
+ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
+{
+  m_N = numOfContents;
+  m_Pcum = nullptr;
 }
 
 uint32_t
@@ -102,7 +138,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_Pcum = nullptr;
 }
 
 double
@@ -115,7 +151,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_Pcum = nullptr;
 }
 
 double
@@ -217,18 +253,7 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-  NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
-
-  m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -239,8 +264,8 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
+  const std::vector<double>& Pcum = GetCumulativeProbabilities();
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
@@ -248,14 +273,12 @@ ConsumerZipfMandelbrot::GetNextSeq()
   }
   // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
+
+  // first i in [1, m_N] with p_random <= Pcum[i], where Pcum[i] = Pcum[i-1] + p[i], p[0] = 0
+  auto it = std::lower_bound(Pcum.begin() + 1, Pcum.end(), p_random);
+  if (it != Pcum.end()) {
+    content_index = static_cast<uint32_t>(it - Pcum.begin());
+  }
   // content_index = 1;
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
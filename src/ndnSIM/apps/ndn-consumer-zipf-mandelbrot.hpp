@@ -37,6 +37,9 @@
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
 
+#include <map>
+#include <tuple>
+
 namespace ns3 {
 namespace ndn {
 
@@ -78,6 +81,14 @@ protected:
   ScheduleNextPacket();
 
 private:
+  /**
+   * \brief Get cumulative probabilities for the current (N, q, s), computing them if needed
+   *
+   * The distribution is shared between all consumer instances that use the same parameters
+   */
+  const std::vector<double>&
+  GetCumulativeProbabilities();
+
   void
   SetNumberOfContents(uint32_t numOfContents);
 
@@ -100,7 +111,10 @@ private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  shared_ptr<const std::vector<double>> m_Pcum; // cumulative probability (computed lazily)
+
+  typedef std::tuple<uint32_t, double, double> Parameters; // (N, q, s)
+  static std::map<Parameters, weak_ptr<const std::vector<double>>> s_distributions;
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
@@ -65,8 +65,8 @@ Consumer::GetTypeId(void)
                     MakeTimeAccessor(&Consumer::m_interestLifeTime), MakeTimeChecker())
 
       .AddAttribute("RetxTimer",
-                    "Timeout defining how frequent retransmission timeouts "
-                    "should be checked",
+                    "Granularity of retransmission timeouts: each timeout is "
+                    "rounded up to a multiple of this interval",
                     StringValue("50ms"),
                     MakeTimeAccessor(&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                     MakeTimeChecker())
@@ -98,13 +98,15 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
+  m_seqTracker.setGranularity(m_retxTimer);
+
   if (m_retxEvent.IsRunning()) {
     // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
     Simulator::Remove(m_retxEvent); // slower, but better for memory
   }
 
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  // schedule event for the timers moved to the new ticks
+  ScheduleRetxCheck();
 }
 
 Time
@@ -116,25 +118,34 @@ Consumer::GetRetxTimer() const
 void
 Consumer::CheckRetxTimeout()
 {
+  m_expiredSeqs.clear();
+  m_seqTracker.expire(Simulator::Now(), m_expiredSeqs);
+
+  for (uint32_t seqNo : m_expiredSeqs) {
+    OnTimeout(seqNo);
+  }
+
+  ScheduleRetxCheck();
+}
+
+void
+Consumer::ScheduleRetxCheck()
+{
+  if (!m_seqTracker.hasTimers()) {
+    return;
+  }
+
   Time now = Simulator::Now();
+  Time nextExpiry = std::max(m_seqTracker.getNextExpiry(), now);
 
-  Time rto = m_rtt->RetransmitTimeout();
-  // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
-
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
+  if (m_retxEvent.IsRunning()) {
+    if (now + Simulator::GetDelayLeft(m_retxEvent) <= nextExpiry) {
+      return; // already scheduled early enough
     }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
+    Simulator::Remove(m_retxEvent);
   }
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  m_retxEvent = Simulator::Schedule(nextExpiry - now, &Consumer::CheckRetxTimeout, this);
 }
 
 // Application Methods
@@ -146,6 +157,7 @@ Consumer::StartApplication() // Called at time specified by Start
   // do base stuff
   App::StartApplication();
 
+  ScheduleRetxCheck();
   ScheduleNextPacket();
 }
 
@@ -156,6 +168,7 @@ Consumer::StopApplication() // Called at time specified by Stop
 
   // cancel periodic packet generation
   Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_retxEvent);
 
   // cleanup base stuff
   App::StopApplication();
@@ -279,22 +292,14 @@ Consumer::OnData(shared_ptr<const Data> data)
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
-
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq],
+  const SeqTracker::State* state = m_seqTracker.find(seq);
+  if (state != nullptr) {
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - state->lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - state->firstSent, state->retxCount,
                              hopCount);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
+  m_seqTracker.erase(seq);
   m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
@@ -328,15 +333,10 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+                                << m_seqTracker.size() << " items");
 
-  m_seqRetxCounts[sequenceNumber]++;
+  m_seqTracker.onSent(sequenceNumber, Simulator::Now(), m_rtt->RetransmitTimeout());
+  ScheduleRetxCheck();
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 }
@@ -21,6 +21,7 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -53,6 +54,11 @@ Producer::GetTypeId(void)
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
                     MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("VirtualPayload",
+                    "If true, Content only declares PayloadSize octets, which are never "
+                    "materialized in memory (see ndn::Data::setVirtualContent)",
+                    BooleanValue(false), MakeBooleanAccessor(&Producer::m_isVirtualPayload),
+                    MakeBooleanChecker())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
                     TimeValue(Seconds(0)), MakeTimeAccessor(&Producer::m_freshness),
                     MakeTimeChecker())
@@ -63,7 +69,17 @@ Producer::GetTypeId(void)
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker())
+      .AddAttribute("DataTemplate",
+                    "If true, all Data fields except Name are encoded once, and each response "
+                    "is created by splicing the requested name into this template",
+                    BooleanValue(false), MakeBooleanAccessor(&Producer::m_isDataTemplate),
+                    MakeBooleanChecker())
+      .AddAttribute("DataCacheSize",
+                    "Number of most recently produced Data packets that are reused as is for "
+                    "repeated Interests, if 0, then no Data is reused",
+                    UintegerValue(0), MakeUintegerAccessor(&Producer::m_dataCacheSize),
+                    MakeUintegerChecker<uint32_t>());
   return tid;
 }
 
@@ -79,6 +95,17 @@ Producer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
+  if (m_isVirtualPayload) {
+    m_virtualContent = Data().setVirtualContent(m_virtualPayloadSize).getContent();
+  }
+
+  if (m_isDataTemplate) {
+    // everything after the (empty) Name element of a fully encoded Data
+    Block wire = makeData(Name())->wireEncode();
+    wire.parse();
+    m_dataTemplate = make_shared< ::ndn::Buffer>(wire.elements().front().end(), wire.end());
+  }
+
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 }
 
@@ -87,6 +114,9 @@ Producer::StopApplication()
 {
   NS_LOG_FUNCTION_NOARGS();
 
+  m_dataCacheQueue.clear();
+  m_dataCache.clear();
+
   App::StopApplication();
 }
 
@@ -104,11 +134,31 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   // dataName.append(m_postfix);
   // dataName.appendVersion();
 
+  shared_ptr<const Data> data = findCachedData(dataName);
+  if (data == nullptr) {
+    data = m_isDataTemplate ? makeDataFromTemplate(dataName) : makeData(dataName);
+    cacheData(data);
+  }
+
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+
+  m_transmittedDatas(data, this, m_face);
+  m_appLink->onReceiveData(*data);
+}
+
+shared_ptr<Data>
+Producer::makeData(const Name& dataName) const
+{
   auto data = make_shared<Data>();
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  if (m_isVirtualPayload) {
+    data->setContent(m_virtualContent);
+  }
+  else {
+    data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  }
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
@@ -122,13 +172,54 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
 
   data->setSignature(signature);
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
-
   // to create real wire encoding
   data->wireEncode();
 
-  m_transmittedDatas(data, this, m_face);
-  m_appLink->onReceiveData(*data);
+  return data;
+}
+
+shared_ptr<Data>
+Producer::makeDataFromTemplate(const Name& dataName) const
+{
+  const Block& nameBlock = dataName.wireEncode();
+  size_t valueLength = nameBlock.size() + m_dataTemplate->size();
+
+  ::ndn::EncodingBuffer encoder(::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Data) +
+                                ::ndn::tlv::sizeOfVarNumber(valueLength) + valueLength, 0);
+  encoder.prependByteArray(m_dataTemplate->data(), m_dataTemplate->size());
+  encoder.prependByteArray(nameBlock.wire(), nameBlock.size());
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(::ndn::tlv::Data);
+
+  return make_shared<Data>(encoder.block());
+}
+
+shared_ptr<const Data>
+Producer::findCachedData(const Name& dataName)
+{
+  auto it = m_dataCache.find(dataName);
+  if (it == m_dataCache.end()) {
+    return nullptr;
+  }
+
+  m_dataCacheQueue.splice(m_dataCacheQueue.begin(), m_dataCacheQueue, it->second);
+  return *it->second;
+}
+
+void
+Producer::cacheData(const shared_ptr<const Data>& data)
+{
+  if (m_dataCacheSize == 0) {
+    return;
+  }
+
+  if (m_dataCache.size() >= m_dataCacheSize) {
+    m_dataCache.erase(m_dataCacheQueue.back()->getName());
+    m_dataCacheQueue.pop_back();
+  }
+
+  m_dataCacheQueue.push_front(data);
+  m_dataCache.emplace(data->getName(), m_dataCacheQueue.begin());
 }
 
 } // namespace ndn
@@ -28,6 +28,9 @@
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
 
+#include <list>
+#include <unordered_map>
+
 namespace ns3 {
 namespace ndn {
 
@@ -59,14 +62,42 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Create and encode Data packet for @p dataName from scratch
+   */
+  shared_ptr<Data>
+  makeData(const Name& dataName) const;
+
+  /**
+   * @brief Create Data packet for @p dataName by splicing the name into the pre-encoded template
+   */
+  shared_ptr<Data>
+  makeDataFromTemplate(const Name& dataName) const;
+
+  shared_ptr<const Data>
+  findCachedData(const Name& dataName);
+
+  void
+  cacheData(const shared_ptr<const Data>& data);
+
 private:
   Name m_prefix;
   Name m_postfix;
   uint32_t m_virtualPayloadSize;
+  bool m_isVirtualPayload;
+  Block m_virtualContent; ///< @brief Content shared by all Data when m_isVirtualPayload is set
   Time m_freshness;
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  bool m_isDataTemplate;
+  shared_ptr<const ::ndn::Buffer> m_dataTemplate; ///< @brief encoded Data elements following the Name
+
+  uint32_t m_dataCacheSize;
+  std::list<shared_ptr<const Data>> m_dataCacheQueue; ///< @brief most recently used first
+  std::unordered_map<Name, std::list<shared_ptr<const Data>>::iterator> m_dataCache;
 };
 
 } // namespace ndn
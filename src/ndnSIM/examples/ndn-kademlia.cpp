@@ -277,9 +277,10 @@ main(int argc, char* argv[])
 
   Simulator::Stop(Seconds(60.0));
 
-  ndn::L3RateTracer::InstallAll("rate-trace.tsv", Seconds(0.5));
-  L2RateTracer::InstallAll("drop-trace.tsv", Seconds(0.5));
-  ndn::AppDelayTracer::InstallAll("app-delays-trace.tsv");
+  ndn::L3RateTracer::InstallAll("rate-trace.csv.gz", Seconds(0.5));
+  L2RateTracer::InstallAll("drop-trace.csv.gz", Seconds(0.5));
+  ndn::AppDelayTracer::InstallAll("app-delays-trace.csv.gz");
+  ndn::KademliaTracer::InstallAll("kademlia-trace.csv.gz", Seconds(0.5));
 
   Simulator::Run();
   Simulator::Destroy();
@@ -23,6 +23,7 @@
 #include "ns3/network-module.h"
 #include "ns3/point-to-point-module.h"
 #include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/model/ndn-net-device-transport.hpp"
 
 /**
  * This scenario demonstrates how to dump raw NDN packets into tcpdump-format
@@ -54,7 +55,9 @@ public:
     static PppHeader pppHeader;
     pppHeader.SetProtocol(0x0077);
 
-    m_pcap->Write(Simulator::Now(), pppHeader, packet);
+    // no-op unless in-process packet passing is enabled, in which case NDN bytes are
+    // serialized only here
+    m_pcap->Write(Simulator::Now(), pppHeader, ndn::NetDeviceTransport::GetSerializedPacket(packet));
   }
 
 private:
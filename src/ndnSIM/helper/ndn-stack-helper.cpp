@@ -116,6 +116,31 @@ StackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+StackHelper::setInProcessPacketPassing(bool enable)
+{
+  m_isInProcessPacketPassing = enable;
+}
+
+void
+StackHelper::setDirectAppDispatch(bool enable)
+{
+  m_isDirectAppDispatch = enable;
+}
+
+void
+StackHelper::setDeadNonceFilter(size_t capacity, double falsePositiveRate)
+{
+  m_deadNonceFilterCapacity = capacity;
+  m_deadNonceFilterFpRate = falsePositiveRate;
+}
+
+void
+StackHelper::setLightweightForwarder(bool enable)
+{
+  m_isLightweightForwarder = enable;
+}
+
 void
 StackHelper::setPolicy(const std::string& policy)
 {
@@ -135,9 +160,11 @@ StackHelper::setPolicy(const std::string& policy)
 void
 StackHelper::Install(const NodeContainer& c) const
 {
+  // queue installation on all nodes, and run the simulator loop only once
   for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
-    Install(*i);
+    scheduleInstall(*i);
   }
+  ProcessWarmupEvents();
 }
 
 void
@@ -148,6 +175,13 @@ StackHelper::InstallAll() const
 
 void
 StackHelper::Install(Ptr<Node> node) const
+{
+  scheduleInstall(node);
+  ProcessWarmupEvents();
+}
+
+void
+StackHelper::scheduleInstall(Ptr<Node> node) const
 {
   if (node->GetObject<L3Protocol>() != 0) {
     NS_FATAL_ERROR("Cannot re-install NDN stack on node "
@@ -155,12 +189,18 @@ StackHelper::Install(Ptr<Node> node) const
     return;
   }
   Simulator::ScheduleWithContext(node->GetId(), Seconds(0), &StackHelper::doInstall, this, node);
-  ProcessWarmupEvents();
 }
 
 void
 StackHelper::doInstall(Ptr<Node> node) const
 {
+  // the same node may have been queued more than once
+  if (node->GetObject<L3Protocol>() != 0) {
+    NS_FATAL_ERROR("Cannot re-install NDN stack on node "
+                   << node->GetId());
+    return;
+  }
+
   // async install to ensure proper context
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
 
@@ -172,14 +212,24 @@ StackHelper::doInstall(Ptr<Node> node) const
     ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
   }
 
+  if (m_isLightweightForwarder) {
+    ndn->getConfig().put("ndnSIM.lightweight", true);
+  }
+
   ndn->setNodeId(node->GetNodeId());
 
   ndn->getConfig().put("tables.cs_max_packets", m_maxCsSize);
   ndn->setCsReplacementPolicy(m_csPolicyCreationFunc);
+  ndn->setDirectAppDispatch(m_isDirectAppDispatch);
 
   // Aggregate L3Protocol on node (must be after setting ndnSIM CS)
   node->AggregateObject(ndn);
 
+  if (m_deadNonceFilterCapacity > 0) {
+    ndn->getForwarder()->getDeadNonceList().enableFilter(m_deadNonceFilterCapacity,
+                                                         m_deadNonceFilterFpRate);
+  }
+
   for (uint32_t index = 0; index < node->GetNDevices(); index++) {
     Ptr<NetDevice> device = node->GetDevice(index);
     // This check does not make sense: LoopbackNetDevice is installed only if IP stack is installed,
@@ -288,6 +338,7 @@ StackHelper::PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   auto transport = make_unique<NetDeviceTransport>(node, netDevice,
                                                    constructFaceUri(netDevice),
                                                    constructFaceUri(remoteNetDevice));
+  transport->setInProcessPacketPassing(m_isInProcessPacketPassing);
 
   auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
   face->setMetric(1);
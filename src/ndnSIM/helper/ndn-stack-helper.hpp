@@ -82,6 +82,48 @@ public:
    */
   void setPolicy(const std::string& policy);
 
+  /**
+   * @brief Enable or disable in-process packet passing on point-to-point faces
+   *
+   * When enabled, ns-3 packets exchanged between NDN nodes carry only the size of the NDN
+   * packet (for link timing) and the Block is handed to the receiver without serialization.
+   * Use NetDeviceTransport::GetSerializedPacket in pcap/packet tracers to get the actual bytes.
+   *
+   * @sa NetDeviceTransport::setInProcessPacketPassing
+   */
+  void setInProcessPacketPassing(bool enable);
+
+  /**
+   * @brief Enable or disable direct dispatch of packets from NFD to applications
+   *
+   * When enabled, packets for applications are delivered right after the forwarder finishes
+   * processing the triggering packet, instead of through a separate simulator event per packet.
+   *
+   * @sa L3Protocol::setDirectAppDispatch
+   */
+  void setDirectAppDispatch(bool enable);
+
+  /**
+   * @brief Store Dead Nonce List entries in a rotating pair of Bloom filters
+   * @param capacity expected number of Nonces added within the Dead Nonce List lifetime
+   *                 on each node; 0 restores the default exact storage
+   * @param falsePositiveRate target probability of considering a new Interest as looping
+   *
+   * @sa nfd::DeadNonceList::enableFilter
+   */
+  void setDeadNonceFilter(size_t capacity, double falsePositiveRate = 0.0001);
+
+  /**
+   * @brief Install only the forwarder and its tables, without management and RIB
+   *
+   * Saves per-node memory and installation time in large topologies.  FibHelper and
+   * StrategyChoiceHelper keep working by modifying the tables directly, but applications
+   * cannot register prefixes through the RIB, and management commands are not served.
+   *
+   * @sa L3Protocol::isLightweight
+   */
+  void setLightweightForwarder(bool enable);
+
   typedef Callback<shared_ptr<Face>, Ptr<Node>, Ptr<L3Protocol>, Ptr<NetDevice>> FaceCreateCallback;
 
   /**
@@ -143,6 +185,9 @@ public:
    * The program will assert if this method is called on a container with a node
    * that already has an ndn object aggregated to it.
    *
+   * Installation on all nodes is queued first, and warmup events are then processed once,
+   * so the simulator loop does not run separately for every node.
+   *
    * \param c NodeContainer that holds the set of nodes on which to install the
    * new stacks.
    *
@@ -210,6 +255,11 @@ public:
   static void ProcessWarmupEvents();
 
 private:
+  /**
+   * @brief Queue installation on @p node, to be completed by ProcessWarmupEvents()
+   */
+  void scheduleInstall(Ptr<Node> node) const;
+
   void doInstall(Ptr<Node> node) const;
 
 private:
@@ -232,6 +282,11 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize = 100;
+  bool m_isInProcessPacketPassing = false;
+  bool m_isDirectAppDispatch = false;
+  bool m_isLightweightForwarder = false;
+  size_t m_deadNonceFilterCapacity = 0;
+  double m_deadNonceFilterFpRate = 0.0;
 
   typedef std::function<std::unique_ptr<nfd::cs::Policy>()> PolicyCreationCallback;
   PolicyCreationCallback m_csPolicyCreationFunc;
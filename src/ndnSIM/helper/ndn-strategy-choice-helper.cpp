@@ -31,6 +31,18 @@ NS_LOG_COMPONENT_DEFINE("ndn.StrategyChoiceHelper");
 void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  if (l3protocol->isLightweight()) {
+    // no management on the node, modify StrategyChoice directly
+    auto res = l3protocol->getForwarder()->getStrategyChoice().insert(parameters.getName(),
+                                                                      parameters.getStrategy());
+    if (!res) {
+      NS_LOG_ERROR("Cannot set strategy " << parameters.getStrategy() << " for "
+                   << parameters.getName() << ": " << res);
+    }
+    return;
+  }
+
   NS_LOG_DEBUG("Strategy choice command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -42,7 +54,6 @@ StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node>
   command->setCanBePrefix(false);
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
   l3protocol->injectInterest(*command);
 }
 
@@ -26,6 +26,7 @@
 #include "ns3/simulator.h"
 
 #include "apps/ndn-app.hpp"
+#include "model/ndn-l3-protocol.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppLinkService");
 
@@ -35,10 +36,12 @@ namespace ndn {
 AppLinkService::AppLinkService(Ptr<App> app)
   : m_node(app->GetNode())
   , m_app(app)
+  , m_l3(PeekPointer(m_node->GetObject<L3Protocol>()))
 {
   NS_LOG_FUNCTION(this << app);
 
   NS_ASSERT(m_app != 0);
+  NS_ASSERT(m_l3 != nullptr);
 }
 
 AppLinkService::~AppLinkService()
@@ -51,6 +54,11 @@ AppLinkService::doSendInterest(const Interest& interest, const nfd::EndpointId&
 {
   NS_LOG_FUNCTION(this << &interest);
 
+  if (m_l3->isDirectAppDispatch()) {
+    m_l3->dispatchToApp(m_app, interest.shared_from_this());
+    return;
+  }
+
   // to decouple callbacks
   Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
 }
@@ -60,6 +68,11 @@ AppLinkService::doSendData(const Data& data, const nfd::EndpointId& endpoint)
 {
   NS_LOG_FUNCTION(this << &data);
 
+  if (m_l3->isDirectAppDispatch()) {
+    m_l3->dispatchToApp(m_app, data.shared_from_this());
+    return;
+  }
+
   // to decouple callbacks
   Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
 }
@@ -69,6 +82,11 @@ AppLinkService::doSendNack(const lp::Nack& nack, const nfd::EndpointId& endpoint
 {
   NS_LOG_FUNCTION(this << &nack);
 
+  if (m_l3->isDirectAppDispatch()) {
+    m_l3->dispatchToApp(m_app, make_shared<lp::Nack>(nack));
+    return;
+  }
+
   // to decouple callbacks
   Simulator::ScheduleNow(&App::OnNack, m_app, make_shared<lp::Nack>(nack));
 }
@@ -78,18 +96,21 @@ AppLinkService::doSendNack(const lp::Nack& nack, const nfd::EndpointId& endpoint
 void
 AppLinkService::onReceiveInterest(const Interest& interest)
 {
+  L3Protocol::ForwarderScope scope(m_l3);
   this->receiveInterest(interest, 0);
 }
 
 void
 AppLinkService::onReceiveData(const Data& data)
 {
+  L3Protocol::ForwarderScope scope(m_l3);
   this->receiveData(data, 0);
 }
 
 void
 AppLinkService::onReceiveNack(const lp::Nack& nack)
 {
+  L3Protocol::ForwarderScope scope(m_l3);
   this->receiveNack(nack, 0);
 }
 
@@ -31,6 +31,7 @@ class Node;
 namespace ndn {
 
 class App;
+class L3Protocol;
 
 /**
  * \ingroup ndn-face
@@ -78,6 +79,7 @@ private:
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+  L3Protocol* m_l3; ///< @brief not Ptr, as L3Protocol owns the face of this link service
 };
 
 } // namespace ndn
@@ -19,6 +19,7 @@
 
 #include "ndn-block-header.hpp"
 
+#include <array>
 #include <iosfwd>
 #include <boost/iostreams/concepts.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -123,6 +124,10 @@ BlockHeader::Print(std::ostream& os) const
       case tlv::Data: {
         Data d(block);
         os << "Data: " << d.getName();
+        size_t virtualSize = d.getVirtualContentSize();
+        if (virtualSize > 0) {
+          os << " (virtual payload " << virtualSize << ")";
+        }
         break;
       }
       case lp::tlv::LpPacket: {
@@ -172,5 +177,95 @@ BlockHeader::getBlock() const
   return m_block;
 }
 
+/**
+ * \brief Find sibling TLV element of \p type in [pos, end) and return its value range
+ */
+static bool
+findElement(const uint8_t*& pos, const uint8_t* end, uint32_t type, const uint8_t*& valueEnd)
+{
+  namespace tlv = ::ndn::tlv;
+
+  while (pos < end) {
+    uint32_t elementType = 0;
+    uint64_t length = 0;
+    if (!tlv::readType(pos, end, elementType) || !tlv::readVarNumber(pos, end, length) ||
+        length > static_cast<uint64_t>(end - pos)) {
+      return false;
+    }
+    if (elementType == type) {
+      valueEnd = pos + length;
+      return true;
+    }
+    pos += length;
+  }
+  return false;
+}
+
+uint32_t
+BlockHeader::getVirtualPayloadPadding(const Block& packet)
+{
+  namespace tlv = ::ndn::tlv;
+  namespace lp = ::ndn::lp;
+
+  if (packet.type() != tlv::Data && packet.type() != lp::tlv::LpPacket) {
+    return 0;
+  }
+
+  // value lengths of enclosing elements, outermost first
+  std::array<uint64_t, 4> lengths;
+  size_t depth = 0;
+
+  const uint8_t* pos = packet.value();
+  const uint8_t* end = pos + packet.value_size();
+  lengths[depth++] = packet.value_size();
+
+  if (packet.type() == lp::tlv::LpPacket) {
+    const uint8_t* fragmentEnd = nullptr;
+    if (!findElement(pos, end, lp::tlv::Fragment, fragmentEnd)) {
+      return 0;
+    }
+    lengths[depth++] = fragmentEnd - pos;
+
+    // fragment must be a complete Data
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (!tlv::readType(pos, fragmentEnd, type) || type != tlv::Data ||
+        !tlv::readVarNumber(pos, fragmentEnd, length) ||
+        length != static_cast<uint64_t>(fragmentEnd - pos)) {
+      return 0;
+    }
+    end = fragmentEnd;
+    lengths[depth++] = length;
+  }
+
+  const uint8_t* contentEnd = nullptr;
+  if (!findElement(pos, end, tlv::Content, contentEnd)) {
+    return 0;
+  }
+  uint64_t contentLength = contentEnd - pos;
+
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readType(pos, contentEnd, type) || type != tlv::VirtualPayload ||
+      !tlv::readVarNumber(pos, contentEnd, length) ||
+      length != static_cast<uint64_t>(contentEnd - pos) ||
+      (length != 1 && length != 2 && length != 4 && length != 8)) {
+    return 0;
+  }
+  uint64_t payloadSize = tlv::readNonNegativeInteger(length, pos, contentEnd);
+  if (payloadSize <= contentLength) {
+    return 0;
+  }
+
+  // growth of Content value, then of each enclosing element, including its length field
+  uint64_t growth = payloadSize - contentLength;
+  growth += tlv::sizeOfVarNumber(payloadSize) - tlv::sizeOfVarNumber(contentLength);
+  while (depth > 0) {
+    uint64_t oldLength = lengths[--depth];
+    growth += tlv::sizeOfVarNumber(oldLength + growth) - tlv::sizeOfVarNumber(oldLength);
+  }
+  return static_cast<uint32_t>(growth);
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -59,6 +59,20 @@ public:
   const Block&
   getBlock() const;
 
+  /**
+   * \brief Get number of octets by which \p packet would grow if its virtual payload
+   *        were materialized
+   *
+   * \p packet can be a Data or an NDNLP packet carrying a Data fragment.  Only TLV headers
+   * are inspected, without decoding or copying.  The returned value accounts for the
+   * increased length fields of all enclosing elements.
+   *
+   * \return 0 if \p packet does not carry a Data with a virtual payload
+   * \sa ndn::Data::setVirtualContent
+   */
+  static uint32_t
+  getVirtualPayloadPadding(const Block& packet);
+
 private:
   Block m_block;
 };
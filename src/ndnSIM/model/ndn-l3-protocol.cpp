@@ -31,6 +31,8 @@
 
 #include "ndn-net-device-transport.hpp"
 
+#include "apps/ndn-app.hpp"
+
 #include "../helper/ndn-stack-helper.hpp"
 
 #include <boost/property_tree/info_parser.hpp>
@@ -104,7 +106,22 @@ L3Protocol::GetTypeId(void)
                       "ns3::ndn::L3Protocol::SatisfiedInterestsCallback")
       .AddTraceSource("TimedOutInterests", "TimedOutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_timedOutInterests),
-                      "ns3::ndn::L3Protocol::TimedOutInterestsCallback");
+                      "ns3::ndn::L3Protocol::TimedOutInterestsCallback")
+      .AddTraceSource("CsHits", "Interests satisfied from the Content Store",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csHits),
+                      "ns3::ndn::L3Protocol::CsHitsCallback")
+
+      ////////////////////////////////////////////////////////////////////
+
+      .AddTraceSource("KademliaLookupStarts", "Interests starting an ID-space lookup",
+                      MakeTraceSourceAccessor(&L3Protocol::m_kademliaLookupStarts),
+                      "ns3::ndn::L3Protocol::KademliaInterestCallback")
+      .AddTraceSource("KademliaIdHops", "Interests forwarded toward the next node in ID space",
+                      MakeTraceSourceAccessor(&L3Protocol::m_kademliaIdHops),
+                      "ns3::ndn::L3Protocol::KademliaIdHopCallback")
+      .AddTraceSource("KademliaAgentSwitches", "Interests switched to NDN routing on this node",
+                      MakeTraceSourceAccessor(&L3Protocol::m_kademliaAgentSwitches),
+                      "ns3::ndn::L3Protocol::KademliaInterestCallback");
   return tid;
 }
 
@@ -194,6 +211,19 @@ private:
   nfd::ConfigSection m_config;
 
   PolicyCreationCallback m_policy;
+
+  struct AppDelivery
+  {
+    Ptr<App> app;
+    AppPacketType type;
+    shared_ptr<const void> packet;
+  };
+
+  bool m_isDirectAppDispatch = false;
+  int m_forwarderDepth = 0;
+  bool m_isDrainingAppQueue = false;
+  std::deque<AppDelivery> m_appQueue;
+  EventId m_drainAppQueueEvent;
 };
 
 L3Protocol::L3Protocol()
@@ -207,18 +237,52 @@ L3Protocol::~L3Protocol()
   NS_LOG_FUNCTION(this);
 }
 
+#ifdef WITH_FORWARDER_PROFILING
+static bool g_isProfileDumpScheduled = false;
+
+static void
+dumpForwarderProfile()
+{
+  ::nfd::fw::ForwarderProfiler& profiler = ::nfd::fw::ForwarderProfiler::get();
+  std::clog << "Forwarding pipeline profile of all nodes (1 in "
+            << profiler.getSamplingInterval() << " calls timed):\n";
+  profiler.print(std::clog);
+
+  profiler.reset();
+  g_isProfileDumpScheduled = false;
+}
+#endif // WITH_FORWARDER_PROFILING
+
 void
 L3Protocol::initialize()
 {
   m_impl->m_faceTable = make_unique<::nfd::FaceTable>();
   m_impl->m_forwarder = make_shared<::nfd::Forwarder>(*m_impl->m_faceTable, *m_impl->m_id);
-  m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
 
-  initializeManagement();
-  initializeRibManager();
+  if (isLightweight()) {
+    initializeTables();
+  }
+  else {
+    m_impl->m_faceSystem = make_unique<::nfd::face::FaceSystem>(*m_impl->m_faceTable, nullptr);
+
+    initializeManagement();
+    initializeRibManager();
+  }
 
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
+  m_impl->m_forwarder->afterCsHit.connect(std::ref(m_csHits));
+
+  m_impl->m_forwarder->afterKademliaLookupStart.connect(std::ref(m_kademliaLookupStarts));
+  m_impl->m_forwarder->afterKademliaIdHop.connect(std::ref(m_kademliaIdHops));
+  m_impl->m_forwarder->afterKademliaAgentSwitch.connect(std::ref(m_kademliaAgentSwitches));
+
+#ifdef WITH_FORWARDER_PROFILING
+  if (!g_isProfileDumpScheduled) {
+    Simulator::ScheduleDestroy(&dumpForwarderProfile);
+    g_isProfileDumpScheduled = true;
+  }
+#endif // WITH_FORWARDER_PROFILING
 }
 
 class IgnoreSections {
@@ -245,6 +309,8 @@ private:
 void
 L3Protocol::injectInterest(const Interest& interest)
 {
+  NS_ASSERT_MSG(m_impl->m_internalClientFaceForInjects != nullptr,
+                "Management is not available on a lightweight forwarder");
   m_impl->m_internalClientFaceForInjects->expressInterest(interest, nullptr, nullptr, nullptr);
 }
 
@@ -330,6 +396,21 @@ L3Protocol::initializeManagement()
   m_impl->m_dispatcher->addTopPrefix(topPrefix, false);
 }
 
+void
+L3Protocol::initializeTables()
+{
+  using namespace nfd;
+
+  auto& forwarder = m_impl->m_forwarder;
+  forwarder->getCs().setPolicy(m_impl->m_policy());
+
+  ConfigFile config(&ConfigFile::ignoreUnknownSection);
+  TablesConfigSection tablesConfig(*forwarder);
+  tablesConfig.setConfigFile(config);
+  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+  tablesConfig.ensureConfigured();
+}
+
 void
 L3Protocol::initializeRibManager()
 {
@@ -365,12 +446,16 @@ L3Protocol::getFibManager()
 nfd::StrategyChoiceManager&
 L3Protocol::getStrategyChoiceManager()
 {
+  NS_ASSERT_MSG(m_impl->m_strategyChoiceManager != nullptr,
+                "StrategyChoiceManager is disabled on this node");
   return *m_impl->m_strategyChoiceManager;
 }
 
 ::nfd::rib::Service&
 L3Protocol::getRibService()
 {
+  NS_ASSERT_MSG(m_impl->m_ribService != nullptr,
+                "RIB service is not available on a lightweight forwarder");
   return *m_impl->m_ribService;
 }
 
@@ -380,6 +465,12 @@ L3Protocol::getConfig()
   return m_impl->m_config;
 }
 
+bool
+L3Protocol::isLightweight()
+{
+  return getConfig().get<bool>("ndnSIM.lightweight", false);
+}
+
 /*
  * This method is called by AddAgregate and completes the aggregation
  * by setting the node in the ndn stack
@@ -397,11 +488,107 @@ L3Protocol::NotifyNewAggregate()
   Object::NotifyNewAggregate();
 }
 
+void
+L3Protocol::setDirectAppDispatch(bool enable)
+{
+  m_impl->m_isDirectAppDispatch = enable;
+}
+
+bool
+L3Protocol::isDirectAppDispatch() const
+{
+  return m_impl->m_isDirectAppDispatch;
+}
+
+void
+L3Protocol::dispatchToApp(Ptr<App> app, shared_ptr<const Interest> interest)
+{
+  enqueueForApp(app, AppPacketType::INTEREST, std::move(interest));
+}
+
+void
+L3Protocol::dispatchToApp(Ptr<App> app, shared_ptr<const Data> data)
+{
+  enqueueForApp(app, AppPacketType::DATA, std::move(data));
+}
+
+void
+L3Protocol::dispatchToApp(Ptr<App> app, shared_ptr<const lp::Nack> nack)
+{
+  enqueueForApp(app, AppPacketType::NACK, std::move(nack));
+}
+
+void
+L3Protocol::enqueueForApp(Ptr<App> app, AppPacketType type, shared_ptr<const void> packet)
+{
+  NS_ASSERT(m_impl->m_isDirectAppDispatch);
+
+  m_impl->m_appQueue.push_back({app, type, std::move(packet)});
+
+  if (m_impl->m_forwarderDepth > 0 || m_impl->m_isDrainingAppQueue) {
+    return; // will be delivered when the forwarder returns
+  }
+
+  // not inside a ForwarderScope (e.g., a forwarder timer), forwarder may still be on the stack
+  if (!m_impl->m_drainAppQueueEvent.IsRunning()) {
+    m_impl->m_drainAppQueueEvent = Simulator::ScheduleNow(&L3Protocol::drainAppQueue, this);
+  }
+}
+
+void
+L3Protocol::drainAppQueue()
+{
+  m_impl->m_isDrainingAppQueue = true;
+
+  // applications may dispatch more packets while being called
+  while (!m_impl->m_appQueue.empty()) {
+    Impl::AppDelivery delivery = std::move(m_impl->m_appQueue.front());
+    m_impl->m_appQueue.pop_front();
+
+    switch (delivery.type) {
+    case AppPacketType::INTEREST:
+      delivery.app->OnInterest(std::static_pointer_cast<const Interest>(delivery.packet));
+      break;
+    case AppPacketType::DATA:
+      delivery.app->OnData(std::static_pointer_cast<const Data>(delivery.packet));
+      break;
+    case AppPacketType::NACK:
+      delivery.app->OnNack(std::static_pointer_cast<const lp::Nack>(delivery.packet));
+      break;
+    }
+  }
+
+  m_impl->m_isDrainingAppQueue = false;
+  Simulator::Cancel(m_impl->m_drainAppQueueEvent);
+}
+
+L3Protocol::ForwarderScope::ForwarderScope(L3Protocol* l3)
+  : m_l3(l3)
+{
+  if (m_l3 != nullptr) {
+    ++m_l3->m_impl->m_forwarderDepth;
+  }
+}
+
+L3Protocol::ForwarderScope::~ForwarderScope()
+{
+  if (m_l3 == nullptr) {
+    return;
+  }
+
+  Impl& impl = *m_l3->m_impl;
+  if (--impl.m_forwarderDepth == 0 && !impl.m_isDrainingAppQueue && !impl.m_appQueue.empty()) {
+    m_l3->drainAppQueue();
+  }
+}
+
 void
 L3Protocol::DoDispose(void)
 {
   NS_LOG_FUNCTION(this);
 
+  Simulator::Cancel(m_impl->m_drainAppQueueEvent);
+
   // MUST HAPPEN BEFORE Simulator IS DESTROYED
   m_impl.reset();
 
@@ -57,6 +57,8 @@ class Header;
 
 namespace ndn {
 
+class App;
+
 /**
  * \defgroup ndn ndnSIM: NDN simulation module
  *
@@ -110,6 +112,7 @@ public:
 
   /**
    * \brief Get smart pointer to nfd::FibManager, used by node's NFD
+   * \return nullptr on a lightweight forwarder
    */
   shared_ptr<nfd::FibManager>
   getFibManager();
@@ -160,6 +163,18 @@ public:
   nfd::ConfigSection&
   getConfig();
 
+  /**
+   * \brief Check whether the node runs only the forwarder and its tables
+   *
+   * A lightweight forwarder, enabled with "ndnSIM.lightweight" config option before the
+   * protocol is aggregated to the node, has no FaceSystem, management dispatcher, managers,
+   * and RIB service.  FIB and strategy choice are then modified directly by FibHelper and
+   * StrategyChoiceHelper, while injectInterest(), getStrategyChoiceManager(), and
+   * getRibService() are not available.
+   */
+  bool
+  isLightweight();
+
   /**
    * \brief Inject interest through internal Face
    */
@@ -180,6 +195,52 @@ public:
   void
   setCsReplacementPolicy(const PolicyCreationCallback& policy);
 
+  /**
+   * \brief Enable or disable direct dispatch of packets from the forwarder to applications
+   *
+   * By default, AppLinkService schedules a separate simulator event for every packet delivered
+   * to an application.  With direct dispatch, such packets are queued on the node and delivered
+   * as soon as the forwarder finishes processing the packet that produced them, within the same
+   * simulator event.
+   */
+  void
+  setDirectAppDispatch(bool enable);
+
+  bool
+  isDirectAppDispatch() const;
+
+  /**
+   * \brief Deliver Interest, Data, or Nack to @p app through the direct dispatch queue
+   * \pre isDirectAppDispatch()
+   */
+  void
+  dispatchToApp(Ptr<App> app, shared_ptr<const Interest> interest);
+
+  void
+  dispatchToApp(Ptr<App> app, shared_ptr<const Data> data);
+
+  void
+  dispatchToApp(Ptr<App> app, shared_ptr<const lp::Nack> nack);
+
+  /**
+   * \brief Marks processing of a packet by the node's forwarder
+   *
+   * Packets dispatched to applications while a scope is alive are delivered when the outermost
+   * scope ends, so applications are never invoked from inside the forwarding pipelines.
+   * A scope with null @p l3 does nothing.
+   */
+  class ForwarderScope : boost::noncopyable
+  {
+  public:
+    explicit
+    ForwarderScope(L3Protocol* l3);
+
+    ~ForwarderScope();
+
+  private:
+    L3Protocol* m_l3;
+  };
+
 public: // Workaround for python bindings
   static Ptr<L3Protocol>
   getL3Protocol(Ptr<Object> node);
@@ -191,6 +252,11 @@ public:
   typedef void (*SatisfiedInterestsCallback)(const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data);
   typedef void (*TimedOutInterestsCallback)(const nfd::pit::Entry& pitEntry);
 
+  typedef void (*CsHitsCallback)(const Interest& interest, const Data& data);
+
+  typedef void (*KademliaInterestCallback)(const Interest& interest);
+  typedef void (*KademliaIdHopCallback)(const Interest& interest, const Name& nextNodeId);
+
 protected:
   virtual void
   DoDispose(void); ///< @brief Do cleanup
@@ -211,9 +277,24 @@ private:
   void
   initializeManagement();
 
+  void
+  initializeTables();
+
   void
   initializeRibManager();
 
+  enum class AppPacketType : uint8_t {
+    INTEREST,
+    DATA,
+    NACK
+  };
+
+  void
+  enqueueForApp(Ptr<App> app, AppPacketType type, shared_ptr<const void> packet);
+
+  void
+  drainAppQueue();
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -234,6 +315,11 @@ private:
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
+  TracedCallback<const Interest&, const Data&> m_csHits;
+
+  TracedCallback<const Interest&> m_kademliaLookupStarts;
+  TracedCallback<const Interest&, const Name&> m_kademliaIdHops;
+  TracedCallback<const Interest&> m_kademliaAgentSwitches;
 };
 
 } // namespace ndn
@@ -28,12 +28,106 @@
 #include <ndn-cxx/data.hpp>
 
 #include "ns3/queue.h"
+#include "ns3/tag.h"
+
+#include <unordered_map>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceTransport");
 
 namespace ns3 {
 namespace ndn {
 
+/**
+ * \brief Packet tag identifying a Block passed in-process by a NetDeviceTransport
+ */
+class InProcessBlockTag : public Tag
+{
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::ndn::InProcessBlockTag")
+      .SetParent<Tag>()
+      .SetGroupName("Ndn")
+      .AddConstructor<InProcessBlockTag>();
+    return tid;
+  }
+
+  InProcessBlockTag() = default;
+
+  InProcessBlockTag(uint32_t senderId, uint64_t seq, uint32_t size)
+    : m_senderId(senderId)
+    , m_seq(seq)
+    , m_size(size)
+  {
+  }
+
+  virtual TypeId
+  GetInstanceTypeId() const
+  {
+    return GetTypeId();
+  }
+
+  virtual uint32_t
+  GetSerializedSize() const
+  {
+    return sizeof(m_senderId) + sizeof(m_seq) + sizeof(m_size);
+  }
+
+  virtual void
+  Serialize(TagBuffer i) const
+  {
+    i.WriteU32(m_senderId);
+    i.WriteU64(m_seq);
+    i.WriteU32(m_size);
+  }
+
+  virtual void
+  Deserialize(TagBuffer i)
+  {
+    m_senderId = i.ReadU32();
+    m_seq = i.ReadU64();
+    m_size = i.ReadU32();
+  }
+
+  virtual void
+  Print(std::ostream& os) const
+  {
+    os << "sender=" << m_senderId << " seq=" << m_seq << " size=" << m_size;
+  }
+
+  uint32_t
+  getSenderId() const
+  {
+    return m_senderId;
+  }
+
+  uint64_t
+  getSeq() const
+  {
+    return m_seq;
+  }
+
+  uint32_t
+  getSize() const
+  {
+    return m_size;
+  }
+
+private:
+  uint32_t m_senderId = 0;
+  uint64_t m_seq = 0;
+  uint32_t m_size = 0;
+};
+
+static std::unordered_map<uint32_t, NetDeviceTransport*>&
+getInProcessSenders()
+{
+  static std::unordered_map<uint32_t, NetDeviceTransport*> senders;
+  return senders;
+}
+
 NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        const Ptr<NetDevice>& netDevice,
                                        const std::string& localUri,
@@ -80,6 +174,41 @@ NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
 NetDeviceTransport::~NetDeviceTransport()
 {
   NS_LOG_FUNCTION_NOARGS();
+
+  if (m_isInProcess) {
+    getInProcessSenders().erase(m_inProcessId);
+  }
+}
+
+void
+NetDeviceTransport::setInProcessPacketPassing(bool enable)
+{
+  if (enable == m_isInProcess) {
+    return;
+  }
+
+  if (enable && DynamicCast<PointToPointNetDevice>(m_netDevice) == nullptr) {
+    NS_LOG_WARN("In-process packet passing is supported only for point-to-point net devices, "
+                "keeping serialization for " << this->getLocalUri());
+    return;
+  }
+
+  if (enable) {
+    static uint32_t lastInProcessId = 0;
+    m_inProcessId = ++lastInProcessId;
+    getInProcessSenders()[m_inProcessId] = this;
+  }
+  else {
+    getInProcessSenders().erase(m_inProcessId);
+    m_inFlight.clear();
+  }
+  m_isInProcess = enable;
+}
+
+bool
+NetDeviceTransport::isInProcessPacketPassing() const
+{
+  return m_isInProcess;
 }
 
 ssize_t
@@ -111,10 +240,31 @@ NetDeviceTransport::doSend(const Block& packet, const nfd::EndpointId& endpoint)
   NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                   << this->getLocalUri());
 
+  // octets of virtual Data payload, sent as zero-filled (not allocated) ns-3 packet area
+  uint32_t padding = BlockHeader::getVirtualPayloadPadding(packet);
+  if (padding > 0 && this->getState() == nfd::face::TransportState::UP) {
+    this->nOutBytes += padding;
+  }
+
+  if (m_isInProcess) {
+    // virtual payload of the same size keeps link-layer timing, the Block itself stays in-process
+    uint32_t size = packet.size() + padding;
+    Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>(size);
+    ns3Packet->AddPacketTag(InProcessBlockTag(m_inProcessId, ++m_inProcessSeq, size));
+    m_inFlight.emplace_back(m_inProcessSeq, packet);
+
+    if (!m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
+                           L3Protocol::ETHERNET_FRAME_TYPE)) {
+      // dropped before reaching the link
+      m_inFlight.pop_back();
+    }
+    return;
+  }
+
   // convert NFD packet to NS3 packet
   BlockHeader header(packet);
 
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
+  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>(padding);
   ns3Packet->AddHeader(header);
 
   // send the NS3 packet
@@ -132,12 +282,37 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
+  if (m_l3 == nullptr) {
+    m_l3 = PeekPointer(m_node->GetObject<L3Protocol>());
+  }
+  L3Protocol::ForwarderScope scope(m_l3);
+
+  InProcessBlockTag tag;
+  if (p->PeekPacketTag(tag)) {
+    NetDeviceTransport* sender = findInProcessSender(tag.getSenderId());
+    Block block;
+    if (sender == nullptr || !sender->takeInFlightBlock(tag.getSeq(), block)) {
+      NS_LOG_WARN("In-process Block " << tag.getSeq() << " from sender " << tag.getSenderId()
+                  << " is no longer available, dropping packet");
+      return;
+    }
+
+    this->nInBytes += tag.getSize() - block.size();
+    this->receive(std::move(block));
+    return;
+  }
+
   // Convert NS3 packet to NFD packet
   Ptr<ns3::Packet> packet = p->Copy();
 
   BlockHeader header;
   packet->RemoveHeader(header);
 
+  // remaining octets, if any, are virtual Data payload
+  if (packet->GetSize() > 0) {
+    this->nInBytes += BlockHeader::getVirtualPayloadPadding(header.getBlock());
+  }
+
   this->receive(std::move(header.getBlock()));
 }
 
@@ -147,5 +322,73 @@ NetDeviceTransport::GetNetDevice() const
   return m_netDevice;
 }
 
+NetDeviceTransport*
+NetDeviceTransport::findInProcessSender(uint32_t senderId)
+{
+  auto& senders = getInProcessSenders();
+  auto it = senders.find(senderId);
+  if (it == senders.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+bool
+NetDeviceTransport::takeInFlightBlock(uint64_t seq, Block& block)
+{
+  // point-to-point links deliver in order, so anything sent before seq has been lost on the way
+  while (!m_inFlight.empty() && m_inFlight.front().first < seq) {
+    m_inFlight.pop_front();
+  }
+
+  if (m_inFlight.empty() || m_inFlight.front().first != seq) {
+    return false;
+  }
+
+  block = std::move(m_inFlight.front().second);
+  m_inFlight.pop_front();
+  return true;
+}
+
+const Block*
+NetDeviceTransport::findInFlightBlock(uint64_t seq) const
+{
+  auto it = std::lower_bound(m_inFlight.begin(), m_inFlight.end(), seq,
+                             [] (const std::pair<uint64_t, Block>& item, uint64_t seq) {
+                               return item.first < seq;
+                             });
+  if (it == m_inFlight.end() || it->first != seq) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+Ptr<const ns3::Packet>
+NetDeviceTransport::GetSerializedPacket(Ptr<const ns3::Packet> packet)
+{
+  InProcessBlockTag tag;
+  if (!packet->PeekPacketTag(tag)) {
+    return packet;
+  }
+
+  NetDeviceTransport* sender = findInProcessSender(tag.getSenderId());
+  const Block* block = sender != nullptr ? sender->findInFlightBlock(tag.getSeq()) : nullptr;
+  if (block == nullptr) {
+    return packet;
+  }
+
+  // the virtual payload is always the trailing part, after any link-layer headers; these are
+  // copied as raw bytes, since trimming the payload with RemoveAtEnd corrupts packet metadata
+  uint32_t headersSize = packet->GetSize() - tag.getSize();
+  std::vector<uint8_t> headers(headersSize);
+  packet->CopyData(headers.data(), headersSize);
+
+  Ptr<ns3::Packet> serialized = Create<ns3::Packet>(headers.data(), headersSize);
+  Ptr<ns3::Packet> payload = Create<ns3::Packet>(tag.getSize() - block->size());
+  payload->AddHeader(BlockHeader(*block));
+  serialized->AddAtEnd(payload);
+  return serialized;
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -32,9 +32,13 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
 
+#include <deque>
+
 namespace ns3 {
 namespace ndn {
 
+class L3Protocol;
+
 /**
  * \ingroup ndn-face
  * \brief ndnSIM-specific transport
@@ -57,6 +61,37 @@ public:
   virtual ssize_t
   getSendQueueLength() final;
 
+  /**
+   * \brief Enable or disable in-process packet passing
+   *
+   * When enabled, the transport does not serialize outgoing Blocks into ns-3 packets.  Instead,
+   * it sends a packet with a virtual (zero-filled, not allocated) payload of the same size as the
+   * Block, so that link-layer timing is unaffected, and hands the reference-counted Block to the
+   * receiving transport directly.  The receiver gets the sender's wire buffer without any copy or
+   * parsing.
+   *
+   * The mode relies on in-order delivery to a single receiver and is therefore only supported
+   * for point-to-point net devices in a single-process simulation; on other devices the request
+   * is ignored.
+   */
+  void
+  setInProcessPacketPassing(bool enable);
+
+  bool
+  isInProcessPacketPassing() const;
+
+  /**
+   * \brief Get ns-3 packet with the actual NDN bytes in place of the virtual payload
+   *
+   * Packets sent in the in-process mode carry no NDN bytes.  Tracers that need the wire
+   * format (e.g., pcap writers) can use this method to serialize the Block lazily, only when
+   * tracing is enabled.  The Block is available while the packet is in flight, i.e., until it
+   * is delivered to the receiving transport.  Packets sent in the normal mode are returned
+   * as is.
+   */
+  static Ptr<const ns3::Packet>
+  GetSerializedPacket(Ptr<const ns3::Packet> packet);
+
 private:
   virtual void
   doClose() override;
@@ -71,11 +106,26 @@ private:
                        const Address& from, const Address& to,
                        NetDevice::PacketType packetType);
 
+  bool
+  takeInFlightBlock(uint64_t seq, Block& block);
+
+  const Block*
+  findInFlightBlock(uint64_t seq) const;
+
+  static NetDeviceTransport*
+  findInProcessSender(uint32_t senderId);
+
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
   Ptr<Node> m_node;
+  L3Protocol* m_l3 = nullptr; ///< \brief cached on first receive, L3Protocol owns this transport
+
+  bool m_isInProcess = false;
+  uint32_t m_inProcessId = 0;
+  uint64_t m_inProcessSeq = 0;
+  std::deque<std::pair<uint64_t, Block>> m_inFlight; ///< \brief Blocks sent in in-process mode
 };
 
 } // namespace ndn
 } // namespace ns3
 
-#endif // NDN_NULL_TRANSPORT_HPP
+#endif // NDN_NET_DEVICE_TRANSPORT_HPP
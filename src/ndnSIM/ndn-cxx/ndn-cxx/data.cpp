@@ -268,6 +268,32 @@ Data::setContent(ConstBufferPtr value)
   return *this;
 }
 
+Data&
+Data::setVirtualContent(size_t size)
+{
+  resetWire();
+  m_content = Block(tlv::Content, makeNonNegativeIntegerBlock(tlv::VirtualPayload, size));
+  m_content.encode();
+  return *this;
+}
+
+size_t
+Data::getVirtualContentSize() const
+{
+  const Block& content = getContent();
+  // avoid Block::parse: an ordinary Content value is not required to be TLV-encoded
+  auto begin = content.value_begin();
+  auto end = content.value_end();
+  uint32_t type = tlv::Invalid;
+  uint64_t length = 0;
+  if (!tlv::readType(begin, end, type) || type != tlv::VirtualPayload ||
+      !tlv::readVarNumber(begin, end, length) ||
+      length != static_cast<uint64_t>(std::distance(begin, end))) {
+    return 0;
+  }
+  return static_cast<size_t>(tlv::readNonNegativeInteger(length, begin, end));
+}
+
 Data&
 Data::setSignature(const Signature& signature)
 {
@@ -323,7 +349,13 @@ operator<<(std::ostream& os, const Data& data)
 {
   os << "Name: " << data.getName() << "\n";
   os << "MetaInfo: " << data.getMetaInfo() << "\n";
-  os << "Content: (size: " << data.getContent().value_size() << ")\n";
+  size_t virtualSize = data.getVirtualContentSize();
+  if (virtualSize > 0) {
+    os << "Content: (virtual size: " << virtualSize << ")\n";
+  }
+  else {
+    os << "Content: (size: " << data.getContent().value_size() << ")\n";
+  }
   os << "Signature: (type: " << data.getSignature().getType()
      << ", value_length: "<< data.getSignature().getValue().value_size() << ")";
   os << std::endl;
@@ -180,6 +180,23 @@ public: // Data fields
   Data&
   setContent(ConstBufferPtr value);
 
+  /** @brief Set Content to a virtual payload of @p size octets
+   *
+   *  The Content element carries only a VirtualPayload element that declares the payload size;
+   *  the payload octets themselves are never materialized.  Intended for simulations, where
+   *  only the size of the content matters.
+   *
+   *  @return a reference to this Data, to allow chaining
+   */
+  Data&
+  setVirtualContent(size_t size);
+
+  /** @brief Get size of the virtual payload declared in Content
+   *  @return declared size, or 0 if Content is not a virtual payload
+   */
+  size_t
+  getVirtualContentSize() const;
+
   /** @brief Get Signature
    */
   const Signature&
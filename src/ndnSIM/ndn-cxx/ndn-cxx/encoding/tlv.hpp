@@ -94,6 +94,7 @@ enum : uint32_t {
   SendDestination = 76,
   HashedName = 77,
   Protocol = 78,
+  VirtualPayload = 79,
 
   NameComponentMin = 1,
   NameComponentMax = 65535,
@@ -137,23 +137,30 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
   std::for_each(m_parameters.rbegin(), m_parameters.rend(),
                 [&](const Block& b) { totalLength += encoder.prependBlock(b); });
 
+  // HashedName, Protocol, AgentNodeID and DestinationNodeID are decoded by position, so an
+  // empty one is still encoded when any of the following ones is present
+  bool hasFollowingName = false;
+
   // DestinationNodeID
   if (!getDestinationNodeID().empty()) {
     totalLength += getDestinationNodeID().wireEncode(encoder);
+    hasFollowingName = true;
   }
 
   // AgentNodeID
-  if (!getAgentNodeID().empty()) {
+  if (hasFollowingName || !getAgentNodeID().empty()) {
     totalLength += getAgentNodeID().wireEncode(encoder);
+    hasFollowingName = true;
   }
 
   // Protocol
-  if (!getProtocol().empty()) {
+  if (hasFollowingName || !getProtocol().empty()) {
     totalLength += getProtocol().wireEncode(encoder);
+    hasFollowingName = true;
   }
 
   // Hashed name
-  if (!getHashedName().empty()) {
+  if (hasFollowingName || !getHashedName().empty()) {
     totalLength += getHashedName().wireEncode(encoder);
   }
 
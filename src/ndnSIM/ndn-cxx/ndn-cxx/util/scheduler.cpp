@@ -26,42 +26,34 @@
 namespace ndn {
 namespace scheduler {
 
-/** \brief Stores internal information about a scheduled event
- */
-class EventInfo : noncopyable
-{
-public:
-  EventInfo(time::nanoseconds after, EventCallback&& cb, uint32_t context)
-    : callback(std::move(cb))
-    , expireTime(time::steady_clock::now() + after)
-    , context(context)
-  {
-  }
+EventInfo::EventInfo(Scheduler* scheduler, EventCallback&& cb)
+  : callback(std::move(cb))
+  , scheduler(scheduler)
+{
+}
 
-  NDN_CXX_NODISCARD time::nanoseconds
-  expiresFromNow() const
-  {
-    return std::max(expireTime - time::steady_clock::now(), 0_ns);
+EventInfo::~EventInfo()
+{
+  // ns-3 drops the events that are still pending when the simulator is destroyed
+  if (isPending()) {
+    scheduler->unlink(*this);
   }
+}
 
-public:
-  EventCallback callback;
-  Scheduler::EventQueue::const_iterator queueIt;
-  time::steady_clock::TimePoint expireTime;
-  bool isExpired = false;
-  uint32_t context = 0;
-};
+void
+EventInfo::Notify()
+{
+  scheduler->executeEvent(*this);
+}
 
-EventId::EventId(Scheduler& sched, weak_ptr<EventInfo> info)
-  : CancelHandle([&sched, info] { sched.cancelImpl(info.lock()); })
-  , m_info(std::move(info))
+EventId::EventId(ns3::Ptr<EventInfo> info) noexcept
+  : m_info(std::move(info))
 {
 }
 
 EventId::operator bool() const noexcept
 {
-  auto sp = m_info.lock();
-  return sp != nullptr && !sp->isExpired;
+  return m_info != nullptr && m_info->isPending();
 }
 
 void
@@ -70,17 +62,20 @@ EventId::reset() noexcept
   *this = {};
 }
 
-std::ostream&
-operator<<(std::ostream& os, const EventId& eventId)
+void
+EventId::cancel() const
 {
-  return os << eventId.m_info.lock();
+  // an event that is not pending may outlive its scheduler
+  if (m_info != nullptr && m_info->isPending()) {
+    m_info->scheduler->cancelImpl(*m_info);
+  }
+  m_info = nullptr;
 }
 
-bool
-Scheduler::EventQueueCompare::operator()(const shared_ptr<EventInfo>& a,
-                                         const shared_ptr<EventInfo>& b) const noexcept
+std::ostream&
+operator<<(std::ostream& os, const EventId& eventId)
 {
-  return a->expireTime < b->expireTime;
+  return os << ns3::PeekPointer(eventId.m_info);
 }
 
 Scheduler::Scheduler(DummyIoService& ioService)
@@ -97,88 +92,92 @@ Scheduler::schedule(time::nanoseconds after, EventCallback callback)
 {
   BOOST_ASSERT(callback != nullptr);
 
-  auto i = m_queue.insert(make_shared<EventInfo>(after, std::move(callback), ns3::Simulator::GetContext()));
-  (*i)->queueIt = i;
+  ns3::Ptr<EventInfo> info(new EventInfo(this, std::move(callback)), false);
+  info->next = m_head;
+  if (m_head != nullptr) {
+    m_head->prev = ns3::PeekPointer(info);
+  }
+  m_head = ns3::PeekPointer(info);
 
-  if (!m_isEventExecuting && i == m_queue.begin()) {
-    // the new event is the first one to expire
-    this->scheduleNext();
+  if (m_isEventExecuting && after <= 0_ns) {
+    // run before the ns-3 events of the same time, as when expired events were processed
+    // together, so that e.g. a PIT entry is finalized before the next packet is received
+    m_dueEvents.push_back(info);
+  }
+  else {
+    // the event keeps the context of the caller, like the ns-3 events scheduled by NFD itself
+    ns3::Simulator::Schedule(ns3::NanoSeconds(std::max(after, 0_ns).count()), info);
   }
 
-  return EventId(*this, *i);
+  return EventId(std::move(info));
 }
 
 void
-Scheduler::cancelImpl(const shared_ptr<EventInfo>& info)
+Scheduler::cancelImpl(EventInfo& info)
 {
-  if (info == nullptr || info->isExpired) {
+  if (!info.isPending()) {
     return;
   }
 
-  if (m_timerEvent) {
-    if (!m_timerEvent->IsExpired()) {
-      ns3::Simulator::Remove(*m_timerEvent);
-    }
-    m_timerEvent.reset();
-  }
-  m_queue.erase(info->queueIt);
-
-  if (!m_isEventExecuting) {
-    this->scheduleNext();
-  }
+  // ns-3 skips cancelled events when they reach the head of the event queue,
+  // release resources held by the callback right away
+  info.Cancel();
+  info.callback = nullptr;
+  unlink(info);
 }
 
 void
-Scheduler::cancelAllEvents()
+Scheduler::unlink(EventInfo& info)
 {
-  m_queue.clear();
-  if (m_timerEvent) {
-    if (!m_timerEvent->IsExpired()) {
-      ns3::Simulator::Remove(*m_timerEvent);
-    }
-    m_timerEvent.reset();
+  if (info.prev != nullptr) {
+    info.prev->next = info.next;
+  }
+  else {
+    m_head = info.next;
   }
+  if (info.next != nullptr) {
+    info.next->prev = info.prev;
+  }
+  info.prev = info.next = nullptr;
 }
 
 void
-Scheduler::scheduleNext()
+Scheduler::cancelAllEvents()
 {
-  if (!m_queue.empty()) {
-    m_timerEvent = ns3::Simulator::Schedule(ns3::NanoSeconds((*m_queue.begin())->expiresFromNow().count()),
-                                            &Scheduler::executeEvent, this);
+  while (m_head != nullptr) {
+    cancelImpl(*m_head);
   }
 }
 
 void
-Scheduler::executeEvent()
+Scheduler::executeEvent(EventInfo& info)
 {
   m_isEventExecuting = true;
-
-  m_timerEvent.reset();
   BOOST_SCOPE_EXIT(this_) {
     this_->m_isEventExecuting = false;
-    this_->scheduleNext();
   } BOOST_SCOPE_EXIT_END
 
-  // process all expired events
-  auto now = time::steady_clock::now();
-  while (!m_queue.empty()) {
-    auto head = m_queue.begin();
-    shared_ptr<EventInfo> info = *head;
-    if (info->expireTime > now) {
-      break;
-    }
+  invokeEvent(info);
 
-    m_queue.erase(head);
-    info->isExpired = true;
-    if (ns3::Simulator::GetContext() == info->context) {
-      info->callback();
-    }
-    else {
-      ns3::Simulator::ScheduleWithContext(info->context, ns3::Seconds(0), ns3::MakeEvent(info->callback));
+  while (!m_dueEvents.empty()) {
+    ns3::Ptr<EventInfo> due = std::move(m_dueEvents.front());
+    m_dueEvents.pop_front();
+    if (due->isPending()) {
+      invokeEvent(*due);
     }
   }
 }
 
+void
+Scheduler::invokeEvent(EventInfo& info)
+{
+  // ns-3 or the queue of due events holds a reference to the event while it is being invoked
+  unlink(info);
+  info.isExpired = true;
+
+  EventCallback callback = std::move(info.callback);
+  callback();
+}
+
 } // namespace scheduler
 } // namespace ndn
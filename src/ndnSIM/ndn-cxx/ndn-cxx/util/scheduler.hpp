@@ -26,9 +26,11 @@
 #include "ndn-cxx/detail/cancel-handle.hpp"
 #include "ndn-cxx/util/time.hpp"
 
+#include "ns3/event-impl.h"
+#include "ns3/ptr.h"
 #include "ns3/simulator.h"
 
-#include <set>
+#include <deque>
 
 namespace ndn {
 
@@ -38,12 +40,44 @@ namespace util {
 namespace scheduler {
 
 class Scheduler;
-class EventInfo;
 
 /** \brief Function to be invoked when a scheduled event expires
  */
 using EventCallback = std::function<void()>;
 
+/** \brief Stores internal information about a scheduled event
+ *
+ *  Each event is scheduled directly as an ns-3 event.  The object is reference-counted
+ *  intrusively by ns-3 and by EventId handles, so scheduling an event needs no allocation
+ *  besides the event itself.
+ */
+class EventInfo : public ns3::EventImpl
+{
+public:
+  EventInfo(Scheduler* scheduler, EventCallback&& cb);
+
+  ~EventInfo();
+
+  bool
+  isPending()
+  {
+    return !isExpired && !IsCancelled();
+  }
+
+protected:
+  void
+  Notify() final;
+
+public:
+  EventCallback callback;
+  Scheduler* scheduler;
+  bool isExpired = false;
+
+  // intrusive list of pending events of the scheduler, used by Scheduler::cancelAllEvents
+  EventInfo* prev = nullptr;
+  EventInfo* next = nullptr;
+};
+
 /** \brief A handle for a scheduled event.
  *
  *  \code
@@ -75,6 +109,14 @@ public:
   void
   reset() noexcept;
 
+  /** \brief Cancel the event.
+   *
+   *  Hides CancelHandle::cancel to cancel the ns-3 event directly, without a type-erased
+   *  cancellation function.
+   */
+  void
+  cancel() const;
+
 private:
   // NOTE: the following "hidden friend" operators are available via
   //       argument-dependent lookup only and must be defined inline.
@@ -85,9 +127,7 @@ private:
   friend bool
   operator==(const EventId& lhs, const EventId& rhs) noexcept
   {
-    return (!lhs && !rhs) ||
-        (!lhs.m_info.owner_before(rhs.m_info) &&
-         !rhs.m_info.owner_before(lhs.m_info));
+    return (!lhs && !rhs) || lhs.m_info == rhs.m_info;
   }
 
   friend bool
@@ -97,10 +137,11 @@ private:
   }
 
 private:
-  EventId(Scheduler& sched, weak_ptr<EventInfo> info);
+  explicit
+  EventId(ns3::Ptr<EventInfo> info) noexcept;
 
 private:
-  weak_ptr<EventInfo> m_info;
+  mutable ns3::Ptr<EventInfo> m_info;
 
   friend class Scheduler;
   friend std::ostream& operator<<(std::ostream& os, const EventId& eventId);
@@ -150,31 +191,23 @@ public:
 
 private:
   void
-  cancelImpl(const shared_ptr<EventInfo>& info);
+  cancelImpl(EventInfo& info);
 
-  /** \brief Schedule the next event on the internal timer
-   */
   void
-  scheduleNext();
+  unlink(EventInfo& info);
 
-  /** \brief Execute expired events
+  /** \brief Execute an expired event, then the events it scheduled without delay
    */
   void
-  executeEvent();
-
-private:
-  class EventQueueCompare
-  {
-  public:
-    bool
-    operator()(const shared_ptr<EventInfo>& a, const shared_ptr<EventInfo>& b) const noexcept;
-  };
+  executeEvent(EventInfo& info);
 
-  using EventQueue = std::multiset<shared_ptr<EventInfo>, EventQueueCompare>;
-  EventQueue m_queue;
+  void
+  invokeEvent(EventInfo& info);
 
+private:
+  EventInfo* m_head = nullptr; ///< first pending event
   bool m_isEventExecuting = false;
-  ndn::optional<ns3::EventId> m_timerEvent;
+  std::deque<ns3::Ptr<EventInfo>> m_dueEvents; ///< events scheduled without delay by a callback
 
   friend EventId;
   friend EventInfo;
@@ -0,0 +1,431 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-scenario-bench.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+
+namespace ns3 {
+
+/**
+ * This program runs a scaled version of the ndn-grid, ndn-tree-* or ndn-kademlia scenario
+ * and reports, as JSON:
+ *
+ *  - wall-clock setup time, split into topology read, stack install, app install and
+ *    route calculation
+ *  - wall-clock simulation time, simulator events processed per second, and packets
+ *    forwarded (Interests, Data and Nacks sent by all forwarders on their non-local faces,
+ *    i.e., excluding the application faces) per second
+ *  - peak resident set size, as reported by MemUsage after each setup phase and every
+ *    second of simulated time
+ *
+ * The topology of the requested size is written to a temporary annotated topology file, so
+ * that reading it with AnnotatedTopologyReader is part of the measurement:
+ *
+ *  - grid:     a square grid, as ndn-grid; all consumers request /prefix from the far corner
+ *  - tree:     a binary tree, as ndn-tree-*; consumers on the leaves request /root/<leaf>
+ *              from the root
+ *  - kademlia: a random connected topology with random node IDs and the KoNDN strategy, as
+ *              ndn-kademlia; consumers request Zipf-Mandelbrot distributed content
+ *
+ * Random choices use a fixed seed, so that the same parameters always produce the same
+ * scenario.  Like the other programs in tests/other, it is built only if the tests are
+ * enabled:
+ *
+ *     ./waf configure --enable-tests
+ *
+ * For example:
+ *
+ *     ./waf --run 'ndn-scenario-bench --scenario=tree --nodes=255 --rate=100 --cs-size=1000
+ *                  --json=tree.json'
+ */
+class ScenarioBench {
+public:
+  ScenarioBench()
+    : m_scenario("grid")
+    , m_nNodes(100)
+    , m_nConsumers(4)
+    , m_interestRate(100)
+    , m_csSize(100)
+    , m_simulationTime(Seconds(10))
+    , m_peakRss(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  /**
+   * @brief Write the annotated topology of the scenario to @p file
+   */
+  void
+  writeTopology(const std::string& file);
+
+  /**
+   * @brief Record wall-clock time of a setup phase started at @p start, and sample memory
+   */
+  void
+  endPhase(const std::string& name, Clock::time_point start);
+
+  /**
+   * @brief Sample memory, and schedule the next sample a second later
+   */
+  void
+  sampleMemory();
+
+  void
+  printJson(std::ostream& os, double simulationWallTime, uint64_t nEvents,
+            uint64_t nForwarded) const;
+
+  /**
+   * @brief Choose up to m_nConsumers nodes, evenly spread over @p candidates
+   *
+   * m_nConsumers is updated to the number of chosen nodes.
+   */
+  NodeContainer
+  chooseConsumers(const NodeContainer& candidates);
+
+private:
+  std::string m_scenario;
+  uint32_t m_nNodes;
+  uint32_t m_nConsumers;
+  double m_interestRate;
+  uint32_t m_csSize;
+  Time m_simulationTime;
+  std::string m_jsonFile;
+
+  std::vector<std::string> m_ids; ///< @brief node IDs of the kademlia scenario
+  std::vector<std::pair<std::string, double>> m_phases;
+  int64_t m_peakRss;
+};
+
+void
+ScenarioBench::writeTopology(const std::string& file)
+{
+  std::ofstream os(file.c_str());
+  std::mt19937 rng(1);
+  std::set<std::pair<uint32_t, uint32_t>> links;
+  std::string linkParameters;
+
+  if (m_scenario == "grid") {
+    uint32_t side = std::max<uint32_t>(2, std::ceil(std::sqrt(m_nNodes)));
+    m_nNodes = side * side;
+    for (uint32_t i = 0; i < m_nNodes; i++) {
+      if ((i + 1) % side != 0) {
+        links.insert({i, i + 1});
+      }
+      if (i + side < m_nNodes) {
+        links.insert({i, i + side});
+      }
+    }
+    linkParameters = "1Mbps\t1\t10ms\t10";
+  }
+  else if (m_scenario == "tree") {
+    m_nNodes = std::max<uint32_t>(m_nNodes, 3);
+    for (uint32_t i = 1; i < m_nNodes; i++) {
+      links.insert({(i - 1) / 2, i});
+    }
+    linkParameters = "10Mbps\t1\t1ms\t100";
+  }
+  else {
+    // a random tree keeps the topology connected, and a random chord per node adds
+    // alternative paths
+    m_nNodes = std::max<uint32_t>(m_nNodes, 2);
+    for (uint32_t i = 1; i < m_nNodes; i++) {
+      links.insert({rng() % i, i});
+    }
+    for (uint32_t i = 0; i < m_nNodes; i++) {
+      uint32_t j = rng() % m_nNodes;
+      if (j != i) {
+        links.insert({std::min(i, j), std::max(i, j)});
+      }
+    }
+    linkParameters = "10Mbps\t1\t1ms\t50";
+
+    static const char digits[] = "0123456789abcdef";
+    for (uint32_t i = 0; i < m_nNodes; i++) {
+      std::string id(40, '0');
+      for (char& c : id) {
+        c = digits[rng() % 16];
+      }
+      m_ids.push_back(id);
+    }
+  }
+
+  // node names follow the scenarios: the tree root is "root", and its leaves are "leaf-<n>"
+  auto name = [this] (uint32_t i) {
+    if (m_scenario == "tree") {
+      if (i == 0) {
+        return std::string("root");
+      }
+      return (2 * i + 1 < m_nNodes ? "rtr-" : "leaf-") + std::to_string(i);
+    }
+    return "rtr-" + std::to_string(i);
+  };
+
+  os << "router\n\n";
+  for (uint32_t i = 0; i < m_nNodes; i++) {
+    // non-zero coordinates, as zero coordinates are replaced with random ones
+    os << name(i) << "\tNA\t" << (i / 32 + 1) << "\t" << (i % 32 + 1) << "\n";
+  }
+  os << "\nlink\n\n";
+  for (const auto& link : links) {
+    os << name(link.first) << "\t" << name(link.second) << "\t" << linkParameters << "\n";
+  }
+}
+
+void
+ScenarioBench::endPhase(const std::string& name, Clock::time_point start)
+{
+  m_phases.push_back({name, std::chrono::duration<double>(Clock::now() - start).count()});
+  m_peakRss = std::max(m_peakRss, MemUsage::Get());
+}
+
+void
+ScenarioBench::sampleMemory()
+{
+  m_peakRss = std::max(m_peakRss, MemUsage::Get());
+  if (Simulator::Now() + Seconds(1) < m_simulationTime) {
+    Simulator::Schedule(Seconds(1), &ScenarioBench::sampleMemory, this);
+  }
+}
+
+NodeContainer
+ScenarioBench::chooseConsumers(const NodeContainer& candidates)
+{
+  uint32_t n = candidates.GetN();
+  if (m_nConsumers != 0) {
+    n = std::min(m_nConsumers, n);
+  }
+
+  NodeContainer consumers;
+  for (uint32_t i = 0; i < n; i++) {
+    consumers.Add(candidates.Get(static_cast<uint64_t>(i) * candidates.GetN() / n));
+  }
+  m_nConsumers = n;
+  return consumers;
+}
+
+void
+ScenarioBench::printJson(std::ostream& os, double simulationWallTime, uint64_t nEvents,
+                         uint64_t nForwarded) const
+{
+  double setupWallTime = 0;
+  for (const auto& phase : m_phases) {
+    setupWallTime += phase.second;
+  }
+
+  os << std::fixed << std::setprecision(6);
+  os << "{\n"
+     << "  \"scenario\": \"" << m_scenario << "\",\n"
+     << "  \"parameters\": {\"nodes\": " << m_nNodes << ", \"consumers\": " << m_nConsumers
+     << ", \"rate\": " << m_interestRate << ", \"cs-size\": " << m_csSize
+     << ", \"sim-time\": " << m_simulationTime.GetSeconds() << "},\n"
+     << "  \"setup\": {";
+  for (const auto& phase : m_phases) {
+    os << "\"" << phase.first << "\": " << phase.second << ", ";
+  }
+  os << "\"total\": " << setupWallTime << "},\n"
+     << "  \"simulation\": {\"wall-time\": " << simulationWallTime
+     << ", \"events\": " << nEvents
+     << ", \"events-per-second\": " << nEvents / simulationWallTime
+     << ", \"packets-forwarded\": " << nForwarded
+     << ", \"packets-forwarded-per-second\": " << nForwarded / simulationWallTime << "},\n"
+     << "  \"peak-rss\": " << m_peakRss << "\n"
+     << "}\n";
+}
+
+int
+ScenarioBench::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("scenario", "Scenario: grid, tree or kademlia", m_scenario);
+  cmd.AddValue("nodes", "Number of nodes (rounded up to a square for grid)", m_nNodes);
+  cmd.AddValue("consumers", "Number of consumer nodes, or 0 for all candidate nodes",
+               m_nConsumers);
+  cmd.AddValue("rate", "Interest rate of each consumer", m_interestRate);
+  cmd.AddValue("cs-size", "Maximum number of cached packets per node", m_csSize);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.AddValue("json", "Write the report to this file instead of the standard output",
+               m_jsonFile);
+  cmd.Parse(argc, argv);
+
+  if (m_scenario != "grid" && m_scenario != "tree" && m_scenario != "kademlia") {
+    std::cerr << "Unknown scenario " << m_scenario << std::endl;
+    return 1;
+  }
+
+  char topologyFile[] = "/tmp/ndn-scenario-bench-XXXXXX";
+  int fd = mkstemp(topologyFile);
+  if (fd < 0) {
+    std::cerr << "Cannot create a temporary topology file" << std::endl;
+    return 1;
+  }
+  close(fd);
+  writeTopology(topologyFile);
+
+  Clock::time_point start = Clock::now();
+  AnnotatedTopologyReader topologyReader("", 1);
+  topologyReader.SetFileName(topologyFile);
+  NodeContainer nodes = m_scenario == "kademlia" ? topologyReader.Read(m_ids)
+                                                 : topologyReader.Read();
+  endPhase("topology-read", start);
+  std::remove(topologyFile);
+
+  start = Clock::now();
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize(m_csSize);
+  ndnHelper.InstallAll();
+  if (m_scenario == "kademlia") {
+    ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/kondn/%FD%05");
+  }
+  else {
+    ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+  }
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  endPhase("stack-install", start);
+
+  start = Clock::now();
+  Ptr<Node> producer;
+  NodeContainer candidates;
+  std::string prefix;
+  if (m_scenario == "grid") {
+    producer = nodes.Get(m_nNodes - 1);
+    for (uint32_t i = 0; i + 1 < m_nNodes; i++) {
+      candidates.Add(nodes.Get(i));
+    }
+    prefix = "/prefix";
+
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix(prefix);
+    consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+    consumerHelper.Install(chooseConsumers(candidates));
+  }
+  else if (m_scenario == "tree") {
+    producer = Names::Find<Node>("root");
+    for (uint32_t i = 0; i < m_nNodes; i++) {
+      if (2 * i + 1 >= m_nNodes) {
+        candidates.Add(nodes.Get(i));
+      }
+    }
+    prefix = "/root";
+
+    NodeContainer consumers = chooseConsumers(candidates);
+    for (NodeContainer::Iterator node = consumers.Begin(); node != consumers.End(); node++) {
+      // each consumer expresses unique interests /root/<leaf-name>/<seq-no>
+      ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+      consumerHelper.SetPrefix(prefix + "/" + Names::FindName(*node));
+      consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+      consumerHelper.Install(*node);
+    }
+  }
+  else {
+    producer = nodes.Get(0);
+    for (uint32_t i = 1; i < m_nNodes; i++) {
+      candidates.Add(nodes.Get(i));
+    }
+    prefix = "/nakazato.lab/test";
+
+    ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+    consumerHelper.SetPrefix(prefix + "/major");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+    consumerHelper.Install(chooseConsumers(candidates));
+  }
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix(prefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+  endPhase("app-install", start);
+
+  start = Clock::now();
+  ndnGlobalRoutingHelper.AddOrigins(prefix, producer);
+  for (uint32_t i = 0; i < m_ids.size(); i++) {
+    ndnGlobalRoutingHelper.AddOrigins("/" + m_ids[i], nodes.Get(i));
+  }
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  endPhase("route-calculation", start);
+
+  Simulator::Stop(m_simulationTime);
+  Simulator::Schedule(Seconds(1), &ScenarioBench::sampleMemory, this);
+
+  uint64_t nEvents = Simulator::GetEventCount();
+  start = Clock::now();
+  Simulator::Run();
+  double simulationWallTime = std::chrono::duration<double>(Clock::now() - start).count();
+  nEvents = Simulator::GetEventCount() - nEvents;
+  m_peakRss = std::max(m_peakRss, MemUsage::Get());
+
+  uint64_t nForwarded = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    for (const nfd::Face& face : (*node)->GetObject<ndn::L3Protocol>()->getFaceTable()) {
+      // packets delivered to applications and NFD's internal faces are not forwarded
+      if (face.getScope() == ::ndn::nfd::FACE_SCOPE_LOCAL) {
+        continue;
+      }
+      const nfd::face::FaceCounters& counters = face.getCounters();
+      nForwarded += counters.nOutInterests + counters.nOutData + counters.nOutNacks;
+    }
+  }
+
+  if (m_jsonFile.empty()) {
+    printJson(std::cout, simulationWallTime, nEvents, nForwarded);
+  }
+  else {
+    std::ofstream os(m_jsonFile.c_str());
+    if (!os.is_open()) {
+      std::cerr << "Cannot open " << m_jsonFile << " for writing" << std::endl;
+      return 1;
+    }
+    printJson(os, simulationWallTime, nEvents, nForwarded);
+  }
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::ScenarioBench bench;
+  return bench.run(argc, argv);
+}
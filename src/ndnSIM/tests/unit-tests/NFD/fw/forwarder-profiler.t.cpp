@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder-profiler.hpp"
+
+#include "../../tests-common.hpp"
+
+#ifdef WITH_FORWARDER_PROFILING
+
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::fw::ForwarderProfiler;
+using nfd::fw::ForwarderStage;
+using Clock = ForwarderProfiler::Clock;
+using ScopedTimer = ForwarderProfiler::ScopedTimer;
+
+BOOST_FIXTURE_TEST_SUITE(NfdFwForwarderProfiler, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Nesting)
+{
+  ForwarderProfiler profiler;
+  profiler.setSamplingInterval(1);
+
+  {
+    ScopedTimer outer(ForwarderStage::INCOMING_INTEREST, profiler);
+    {
+      ScopedTimer inner(ForwarderStage::PIT_INSERT, profiler);
+    }
+    {
+      ScopedTimer inner(ForwarderStage::DISPATCH_TO_STRATEGY, profiler);
+      ScopedTimer innermost(ForwarderStage::LOOKUP_FIB, profiler);
+    }
+  }
+
+  const auto& incoming = profiler.getStats(ForwarderStage::INCOMING_INTEREST);
+  const auto& pitInsert = profiler.getStats(ForwarderStage::PIT_INSERT);
+  const auto& dispatch = profiler.getStats(ForwarderStage::DISPATCH_TO_STRATEGY);
+  const auto& lookupFib = profiler.getStats(ForwarderStage::LOOKUP_FIB);
+  BOOST_CHECK_EQUAL(incoming.nCalls, 1);
+  BOOST_CHECK_EQUAL(incoming.nSampledCalls, 1);
+  BOOST_CHECK_EQUAL(lookupFib.nCalls, 1);
+  BOOST_CHECK_EQUAL(profiler.getStats(ForwarderStage::INCOMING_DATA).nCalls, 0);
+
+  // exclusive time of a stage excludes exactly the inclusive time of the nested stages
+  BOOST_CHECK(incoming.sampledInclusiveTime ==
+              incoming.sampledExclusiveTime + pitInsert.sampledInclusiveTime +
+              dispatch.sampledInclusiveTime);
+  BOOST_CHECK(dispatch.sampledInclusiveTime ==
+              dispatch.sampledExclusiveTime + lookupFib.sampledInclusiveTime);
+  BOOST_CHECK(lookupFib.sampledInclusiveTime == lookupFib.sampledExclusiveTime);
+
+  profiler.reset();
+  BOOST_CHECK_EQUAL(profiler.getStats(ForwarderStage::INCOMING_INTEREST).nCalls, 0);
+  BOOST_CHECK(profiler.getStats(ForwarderStage::INCOMING_INTEREST).sampledInclusiveTime ==
+              Clock::duration::zero());
+}
+
+BOOST_AUTO_TEST_CASE(Sampling)
+{
+  ForwarderProfiler profiler;
+  profiler.setSamplingInterval(4);
+  BOOST_CHECK_EQUAL(profiler.getSamplingInterval(), 4);
+
+  for (int i = 0; i < 10; ++i) {
+    ScopedTimer outer(ForwarderStage::INCOMING_DATA, profiler);
+    ScopedTimer inner(ForwarderStage::FIND_ALL_DATA_MATCHES, profiler);
+  }
+
+  // outermost calls 0, 4 and 8 are timed, together with their nested stages
+  const auto& incoming = profiler.getStats(ForwarderStage::INCOMING_DATA);
+  const auto& matches = profiler.getStats(ForwarderStage::FIND_ALL_DATA_MATCHES);
+  BOOST_CHECK_EQUAL(incoming.nCalls, 10);
+  BOOST_CHECK_EQUAL(incoming.nSampledCalls, 3);
+  BOOST_CHECK_EQUAL(matches.nCalls, 10);
+  BOOST_CHECK_EQUAL(matches.nSampledCalls, 3);
+
+  BOOST_CHECK(incoming.getInclusiveTime() >= incoming.sampledInclusiveTime);
+  BOOST_CHECK(incoming.getInclusiveTime() <= incoming.sampledInclusiveTime * 4);
+
+  std::ostringstream os;
+  profiler.print(os);
+  BOOST_CHECK(boost::contains(os.str(), "onIncomingData"));
+  BOOST_CHECK(boost::contains(os.str(), "findAllDataMatches"));
+  BOOST_CHECK(!boost::contains(os.str(), "onIncomingInterest"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // WITH_FORWARDER_PROFILING
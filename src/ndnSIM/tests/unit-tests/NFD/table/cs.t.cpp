@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class CsFixture : public CleanupFixture
+{
+protected:
+  /** \brief inserts Data named \p name whose content is \p value
+   *  \return full name of the inserted Data
+   */
+  Name
+  insert(const Name& name, uint64_t value, bool isAgent = false)
+  {
+    shared_ptr<Data> data = makeData(name, value);
+    cs.insert(*data, false, isAgent);
+    return data->getFullName();
+  }
+
+  /** \return Data named \p name whose content is \p value
+   */
+  static shared_ptr<Data>
+  makeData(const Name& name, uint64_t value)
+  {
+    auto data = make_shared<Data>(name);
+    data->setFreshnessPeriod(::ndn::time::seconds(10));
+    data->setContent(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::Content, value));
+
+    ::ndn::Signature signature;
+    signature.setInfo(::ndn::SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)));
+    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+    data->wireEncode();
+    return data;
+  }
+
+  /** \return full name of the Data found for \p name, or an empty name on a miss
+   */
+  Name
+  find(const Name& name, bool canBePrefix = false)
+  {
+    Interest interest(name);
+    interest.setCanBePrefix(canBePrefix);
+
+    Name found;
+    cs.find(interest,
+            [&] (const Interest&, const Data& data) { found = data.getFullName(); },
+            [] (const Interest&) {});
+    return found;
+  }
+
+protected:
+  nfd::cs::Cs cs;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdTableCs, CsFixture)
+
+BOOST_AUTO_TEST_CASE(ExactMatch)
+{
+  Name fullNameAB = insert("/A/B", 1);
+  Name fullNameAC = insert("/A/C", 2);
+
+  BOOST_CHECK_EQUAL(find("/A/B"), fullNameAB);
+  BOOST_CHECK_EQUAL(find("/A/C"), fullNameAC);
+  BOOST_CHECK_EQUAL(find("/A/D"), Name());
+
+  // an exact Interest does not match longer names, a prefix Interest does
+  BOOST_CHECK_EQUAL(find("/A"), Name());
+  BOOST_CHECK_EQUAL(find("/A", true), fullNameAB);
+
+  // a full name is looked up in the Table
+  BOOST_CHECK_EQUAL(find(fullNameAC), fullNameAC);
+}
+
+BOOST_AUTO_TEST_CASE(ExactMatchSameNameDifferentDigests)
+{
+  Name fullName1 = insert("/A", 1);
+  Name fullName2 = insert("/A", 2);
+  Name fullName3 = insert("/A", 3);
+  BOOST_REQUIRE_EQUAL(cs.size(), 3);
+
+  // the exact index picks the same entry as the search of the Table
+  Name expected = std::min({fullName1, fullName2, fullName3});
+  BOOST_CHECK_EQUAL(find("/A", true), expected);
+  BOOST_CHECK_EQUAL(find("/A"), expected);
+}
+
+BOOST_AUTO_TEST_CASE(ExactMatchAfterErase)
+{
+  cs.setLimit(2);
+
+  insert("/A", 1);
+  Name fullNameB = insert("/B", 2);
+  Name fullNameC = insert("/C", 3); // evicts /A
+  BOOST_REQUIRE_EQUAL(cs.size(), 2);
+
+  BOOST_CHECK_EQUAL(find("/A"), Name());
+  BOOST_CHECK_EQUAL(find("/B"), fullNameB);
+  BOOST_CHECK_EQUAL(find("/C"), fullNameC);
+
+  size_t nErased = 0;
+  cs.erase("/B", 10, [&] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(nErased, 1);
+  BOOST_CHECK_EQUAL(find("/B"), Name());
+  BOOST_CHECK_EQUAL(find("/C"), fullNameC);
+
+  // an entry can be inserted again after it was erased from the index
+  Name fullNameA = insert("/A", 4);
+  BOOST_CHECK_EQUAL(find("/A"), fullNameA);
+}
+
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  cs.setLimit(2);
+
+  insert("/A", 1);
+  insert("/B", 2, true);
+  insert("/A", 1); // refresh
+  BOOST_CHECK_EQUAL(cs.getCounters().nInserts, 2);
+  BOOST_CHECK_EQUAL(cs.getCounters().nAgentInserts, 1);
+
+  BOOST_CHECK_NE(find("/A"), Name());
+  BOOST_CHECK_NE(find("/B"), Name());
+  BOOST_CHECK_EQUAL(find("/C"), Name());
+  BOOST_CHECK_EQUAL(cs.getCounters().nHits, 2);
+  BOOST_CHECK_EQUAL(cs.getCounters().nAgentHits, 1);
+  BOOST_CHECK_EQUAL(cs.getCounters().nMisses, 1);
+
+  // LRU policy evicts the non-agent entries first
+  insert("/D", 4);
+  BOOST_CHECK_EQUAL(cs.getCounters().nEvictions, 1);
+  BOOST_CHECK_EQUAL(cs.getCounters().nAgentEvictions, 0);
+  insert("/E", 5);
+  BOOST_CHECK_EQUAL(cs.getCounters().nEvictions, 2);
+  BOOST_CHECK_EQUAL(cs.getCounters().nAgentEvictions, 0);
+  BOOST_CHECK_NE(find("/B"), Name());
+
+  // erasure is not an eviction
+  size_t nErased = 0;
+  cs.erase("/", 10, [&] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(nErased, 2);
+  BOOST_CHECK_EQUAL(cs.getCounters().nEvictions, 2);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryUsage)
+{
+  insert("/A", 1);
+  insert("/B", 2);
+  size_t nErased = 0;
+  cs.erase("/B", 10, [&] (size_t n) { nErased = n; });
+  BOOST_REQUIRE_EQUAL(nErased, 1);
+  size_t usageA = cs.getMemoryUsage();
+
+  // an entry is accounted with the wire encoding of its Data, and its Table and index nodes
+  insert("/B", 2);
+  size_t usageAB = cs.getMemoryUsage();
+  BOOST_CHECK_GT(usageAB - usageA, makeData("/B", 2)->wireEncode().size());
+
+  insert("/A", 1); // refresh
+  BOOST_CHECK_EQUAL(cs.getMemoryUsage(), usageAB);
+
+  // erasure and eviction release what insertion has added
+  cs.erase("/B", 10, [&] (size_t n) { nErased = n; });
+  BOOST_CHECK_EQUAL(cs.getMemoryUsage(), usageA);
+  insert("/B", 2);
+  BOOST_CHECK_EQUAL(cs.getMemoryUsage(), usageAB);
+  cs.setLimit(1);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getMemoryUsage(), usageA);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
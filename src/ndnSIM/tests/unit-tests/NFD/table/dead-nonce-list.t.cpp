@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/dead-nonce-list.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::DeadNonceList;
+
+/**
+ * @brief Fixture that adds Nonces to a Dead Nonce List at a constant rate as the simulation runs
+ */
+class DeadNonceListFixture : public CleanupFixture
+{
+protected:
+  DeadNonceListFixture()
+    : dnl(LIFETIME)
+  {
+  }
+
+  void
+  setRate(size_t nNoncesPerLifetime)
+  {
+    addNonceBatch = nNoncesPerLifetime / MARKS_PER_LIFETIME;
+    if (!addNonceEvent.IsRunning()) {
+      addNonce();
+    }
+  }
+
+  void
+  addNonce()
+  {
+    for (size_t i = 0; i < addNonceBatch; ++i) {
+      dnl.add(name, ++lastNonce);
+    }
+    addNonceEvent = Simulator::Schedule(ADD_NONCE_INTERVAL, &DeadNonceListFixture::addNonce, this);
+  }
+
+  void
+  advanceClocksByLifetime(double t)
+  {
+    Simulator::Stop(NanoSeconds(static_cast<int64_t>(LIFETIME.count() * t)));
+    Simulator::Run();
+  }
+
+protected:
+  static const ::ndn::time::nanoseconds LIFETIME;
+  /// DeadNonceList::EXPECTED_MARK_COUNT
+  static const size_t MARKS_PER_LIFETIME = 5;
+  /// DeadNonceList::INITIAL_CAPACITY
+  static const size_t INITIAL_CAPACITY = 128;
+  static const Time ADD_NONCE_INTERVAL;
+
+  DeadNonceList dnl;
+  Name name = "/N";
+  uint32_t lastNonce = 0;
+  size_t addNonceBatch = 0;
+  EventId addNonceEvent;
+};
+
+const ::ndn::time::nanoseconds DeadNonceListFixture::LIFETIME = ::ndn::time::milliseconds(200);
+const size_t DeadNonceListFixture::MARKS_PER_LIFETIME;
+const size_t DeadNonceListFixture::INITIAL_CAPACITY;
+const Time DeadNonceListFixture::ADD_NONCE_INTERVAL = MilliSeconds(200 / MARKS_PER_LIFETIME);
+
+BOOST_FIXTURE_TEST_SUITE(NfdTableDeadNonceList, DeadNonceListFixture)
+
+BOOST_AUTO_TEST_CASE(MemoryUsage)
+{
+  // entries stored in the index are accounted one by one
+  for (uint32_t nonce = 1; nonce <= 4; ++nonce) {
+    dnl.add(name, nonce);
+  }
+  size_t usage4 = dnl.getMemoryUsage();
+  dnl.add(name, 5);
+  size_t usage5 = dnl.getMemoryUsage();
+  dnl.add(name, 6);
+  BOOST_CHECK_GT(usage5, usage4);
+  BOOST_CHECK_EQUAL(dnl.getMemoryUsage() - usage5, usage5 - usage4);
+
+  // the Bloom filters have a fixed size
+  dnl.enableFilter(INITIAL_CAPACITY, 0.001);
+  size_t filterUsage = dnl.getMemoryUsage();
+  BOOST_CHECK_GT(filterUsage, 0);
+
+  this->setRate(INITIAL_CAPACITY / 2);
+  this->advanceClocksByLifetime(3.0);
+  BOOST_CHECK_GT(dnl.size(), 6);
+  BOOST_CHECK_EQUAL(dnl.getMemoryUsage(), filterUsage);
+}
+
+BOOST_AUTO_TEST_CASE(Filter)
+{
+  Name nameA("/A");
+  const uint32_t nonceA = 0x2e1f8d3a;
+  dnl.add(nameA, nonceA);
+
+  BOOST_CHECK_THROW(dnl.enableFilter(0, 0.01), std::invalid_argument);
+  BOOST_CHECK_THROW(dnl.enableFilter(1000, 1.0), std::invalid_argument);
+  BOOST_CHECK(!dnl.isFilterEnabled());
+
+  dnl.enableFilter(INITIAL_CAPACITY, 0.001);
+  BOOST_CHECK(dnl.isFilterEnabled());
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonceA), true); // migrated from the index
+
+  this->setRate(INITIAL_CAPACITY / 2);
+  this->advanceClocksByLifetime(10.0);
+
+  Name nameC("/C");
+  const uint32_t nonceC = 0x25390656;
+  dnl.add(nameC, nonceC);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(0.5); // entry is kept for at least lifetime
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(1.6); // and less than twice the lifetime
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+  BOOST_CHECK_LT(dnl.size(), INITIAL_CAPACITY);
+
+  // lookups of Nonces that have never been added
+  const uint64_t nLookups0 = dnl.getCounters().nLookups;
+  const uint64_t nHits0 = dnl.getCounters().nHits;
+  const int N_LOOKUPS = 100000;
+  int nFalsePositives = 0;
+  for (int i = 0; i < N_LOOKUPS; ++i) {
+    nFalsePositives += dnl.has(nameC, 0x80000000 + i);
+  }
+  BOOST_CHECK_EQUAL(dnl.getCounters().nLookups - nLookups0, N_LOOKUPS);
+  BOOST_CHECK_EQUAL(dnl.getCounters().nHits - nHits0, nFalsePositives);
+  BOOST_CHECK_GT(dnl.getFalsePositiveRate(), 0.0);
+  BOOST_CHECK_LE(dnl.getFalsePositiveRate(), 0.001);
+  BOOST_CHECK_LE(nFalsePositives, N_LOOKUPS * 0.002);
+}
+
+BOOST_AUTO_TEST_CASE(FilterEarlyRotation)
+{
+  dnl.enableFilter(100, 0.001);
+
+  // Nonces are added much faster than the capacity allows
+  this->setRate(1000);
+  this->advanceClocksByLifetime(3.0);
+
+  // the current filter never holds more than its capacity
+  BOOST_CHECK_LE(dnl.size(), 2 * 100);
+  BOOST_CHECK_LE(dnl.getFalsePositiveRate(), 0.001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/fib.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/null-face.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::NameTree;
+using nfd::Fib;
+using nfd::fib::Entry;
+using nfd::fib::NextHop;
+
+BOOST_FIXTURE_TEST_SUITE(NfdTableFib, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchMarkers)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  fib.insert("/A");
+  fib.insert("/B/C/D/E");
+  fib.insert("/A/B/C/D/E/F");
+
+  // name tree entries of other tables and ancestors of longer FIB entries are markers
+  nameTree.lookup("/A/B/C/D/E/G/H");
+  nameTree.lookup("/B/C/D/E/F/G");
+
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E/G/H/I").getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E/F/G").getPrefix(), "/A/B/C/D/E/F");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/B/C/D/E/F/G").getPrefix(), "/B/C/D/E");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/B/C/D").getPrefix(), "/"); // the empty entry
+
+  fib.erase("/A/B/C/D/E/F");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E/F/G").getPrefix(), "/A");
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E/F/G").getPrefix(), "/");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/B/C/D/E/F/G").getPrefix(), "/B/C/D/E");
+}
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchBeyondMaxDepth)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+
+  Name longPrefix("/A");
+  while (longPrefix.size() <= NameTree::getMaxDepth() + 5) {
+    longPrefix.appendNumber(longPrefix.size());
+  }
+
+  BOOST_CHECK_NO_THROW(fib.insert(longPrefix));
+  BOOST_CHECK_NO_THROW(fib.insert("/A"));
+  BOOST_CHECK_EQUAL(fib.size(), 2);
+  BOOST_REQUIRE(fib.findExactMatch(longPrefix) != nullptr);
+  BOOST_CHECK_EQUAL(fib.findExactMatch(longPrefix)->getPrefix(), longPrefix);
+
+  // the entry is attached to the name tree entry at the maximum depth
+  Name longName = Name(longPrefix).append("B");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(longName).getPrefix(), longPrefix);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B").getPrefix(), "/A");
+
+  BOOST_CHECK_NO_THROW(fib.erase(longPrefix));
+  BOOST_CHECK_EQUAL(fib.size(), 1);
+  BOOST_CHECK(fib.findExactMatch(longPrefix) == nullptr);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(longName).getPrefix(), "/A");
+
+  // counts by length are consistent again, so the entry can be inserted and erased once more
+  BOOST_CHECK_NO_THROW(fib.insert(longPrefix));
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(longName).getPrefix(), longPrefix);
+  BOOST_CHECK_NO_THROW(fib.erase(longPrefix));
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(longName).getPrefix(), "/A");
+}
+
+BOOST_AUTO_TEST_CASE(MemoryUsage)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  size_t nameTreeUsageBefore = nameTree.getMemoryUsage();
+  size_t fibUsageBefore = fib.getMemoryUsage();
+
+  shared_ptr<nfd::Face> face1 = nfd::face::makeNullFace();
+  shared_ptr<nfd::Face> face2 = nfd::face::makeNullFace();
+
+  Entry& entry = *fib.insert("/A/B").first;
+  BOOST_CHECK_EQUAL(fib.getMemoryUsage(), fibUsageBefore + sizeof(Entry));
+  BOOST_CHECK_GT(nameTree.getMemoryUsage(), nameTreeUsageBefore);
+
+  fib.addOrUpdateNextHop(entry, *face1, 10);
+  fib.addOrUpdateNextHop(entry, *face2, 20);
+  fib.addOrUpdateNextHop(entry, *face1, 30);
+  BOOST_CHECK_EQUAL(fib.getMemoryUsage(), fibUsageBefore + sizeof(Entry) + 2 * sizeof(NextHop));
+
+  fib.removeNextHop(entry, *face2);
+  BOOST_CHECK_EQUAL(fib.getMemoryUsage(), fibUsageBefore + sizeof(Entry) + sizeof(NextHop));
+
+  fib.erase("/A/B");
+  BOOST_CHECK_EQUAL(fib.getMemoryUsage(), fibUsageBefore);
+
+  // removing the last nexthop erases the entry
+  Entry& entry2 = *fib.insert("/A/B").first;
+  fib.addOrUpdateNextHop(entry2, *face1, 10);
+  fib.removeNextHop(entry2, *face1);
+  BOOST_CHECK_EQUAL(fib.getMemoryUsage(), fibUsageBefore);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/pit.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::NameTree;
+using nfd::Pit;
+
+BOOST_FIXTURE_TEST_SUITE(NfdTablePit, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(MemoryUsage)
+{
+  NameTree nameTree;
+  Pit pit(nameTree);
+  size_t usageBefore = pit.getMemoryUsage();
+
+  auto interestA = make_shared<Interest>("/A");
+  interestA->setNonce(1);
+  size_t sizeA = interestA->wireEncode().size();
+  shared_ptr<nfd::pit::Entry> entryA = pit.insert(*interestA).first;
+  BOOST_CHECK_EQUAL(entryA->getInterestSize(), sizeA);
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage(), usageBefore + sizeof(nfd::pit::Entry) + sizeA);
+
+  // an Interest that matches an existing entry adds nothing
+  auto interestA2 = make_shared<Interest>("/A");
+  interestA2->setNonce(2);
+  BOOST_CHECK(!pit.insert(*interestA2).second);
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage(), usageBefore + sizeof(nfd::pit::Entry) + sizeA);
+
+  auto interestB = make_shared<Interest>("/B/C");
+  interestB->setNonce(3);
+  size_t sizeB = interestB->wireEncode().size();
+  shared_ptr<nfd::pit::Entry> entryB = pit.insert(*interestB).first;
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage(),
+                    usageBefore + 2 * sizeof(nfd::pit::Entry) + sizeA + sizeB);
+
+  // KoNDNStrategy changes the representative Interest in place, erasing must not depend on it
+  entryA->getInterest().setProtocol("ndn");
+  entryA->getInterest().setDestinationNodeID("/be43a63a0fa44ec48dd74e52ed24aa6b00000000");
+  BOOST_CHECK_NE(entryA->getInterest().wireEncode().size(), sizeA);
+  BOOST_CHECK_EQUAL(entryA->getInterestSize(), sizeA);
+
+  pit.erase(entryA.get());
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage(), usageBefore + sizeof(nfd::pit::Entry) + sizeB);
+  pit.erase(entryB.get());
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage(), usageBefore);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
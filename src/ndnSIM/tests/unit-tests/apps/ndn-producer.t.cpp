@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-producer.hpp"
+#include "helper/ndn-app-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ProducerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ProducerFixture()
+  {
+    createTopology({
+        {"1"}
+      });
+  }
+
+  Ptr<App>
+  installProducer(bool isDataTemplate, uint32_t dataCacheSize)
+  {
+    AppHelper helper("ns3::ndn::Producer");
+    helper.SetAttribute("Prefix", StringValue("/prefix"));
+    helper.SetAttribute("PayloadSize", UintegerValue(100));
+    helper.SetAttribute("Freshness", TimeValue(Seconds(2)));
+    helper.SetAttribute("Signature", UintegerValue(7));
+    helper.SetAttribute("KeyLocator", StringValue("/key"));
+    helper.SetAttribute("DataTemplate", BooleanValue(isDataTemplate));
+    helper.SetAttribute("DataCacheSize", UintegerValue(dataCacheSize));
+
+    Ptr<App> producer = DynamicCast<App>(helper.Install(getNode("1")).Get(0));
+    producer->TraceConnectWithoutContext("TransmittedDatas",
+                                         MakeCallback(&ProducerFixture::onData, this));
+    return producer;
+  }
+
+  /**
+   * @brief Deliver Interests for @p names to @p producer, one every 100ms
+   */
+  void
+  expressInterests(Ptr<App> producer, const std::vector<Name>& names)
+  {
+    Time when = Seconds(1);
+    for (const Name& name : names) {
+      Simulator::Schedule(when, &App::OnInterest, producer, make_shared<Interest>(name));
+      when += MilliSeconds(100);
+    }
+  }
+
+  void
+  run()
+  {
+    Simulator::Stop(Seconds(10.0));
+    Simulator::Run();
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face>)
+  {
+    transmittedData[app].push_back(data);
+  }
+
+public:
+  std::map<Ptr<App>, std::vector<shared_ptr<const Data>>> transmittedData;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnProducer, ProducerFixture)
+
+BOOST_AUTO_TEST_CASE(DataTemplate)
+{
+  Ptr<App> plain = installProducer(false, 0);
+  Ptr<App> templated = installProducer(true, 0);
+
+  std::vector<Name> names{"/prefix/a", "/prefix/b/c", "/prefix/a", "/prefix/%FD%01/d"};
+  expressInterests(plain, names);
+  expressInterests(templated, names);
+  run();
+
+  BOOST_REQUIRE_EQUAL(transmittedData[plain].size(), names.size());
+  BOOST_REQUIRE_EQUAL(transmittedData[templated].size(), names.size());
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    const Data& expected = *transmittedData[plain][i];
+    const Data& actual = *transmittedData[templated][i];
+
+    BOOST_CHECK_EQUAL(actual.getName(), names[i]);
+    BOOST_CHECK_EQUAL(actual.getContent().value_size(), 100);
+    BOOST_CHECK_EQUAL(actual.getFreshnessPeriod(), ::ndn::time::seconds(2));
+    BOOST_CHECK_EQUAL(actual.getSignature().getKeyLocator().getName(), "/key");
+
+    // splicing the name into the template yields the same packet as encoding it from scratch
+    const Block& expectedWire = expected.wireEncode();
+    const Block& actualWire = actual.wireEncode();
+    BOOST_CHECK_EQUAL_COLLECTIONS(actualWire.begin(), actualWire.end(),
+                                  expectedWire.begin(), expectedWire.end());
+  }
+
+  // without a reply cache, every Interest gets a freshly created Data
+  BOOST_CHECK(transmittedData[templated][0] != transmittedData[templated][2]);
+}
+
+BOOST_AUTO_TEST_CASE(DataCacheLru)
+{
+  Ptr<App> producer = installProducer(true, 2);
+
+  expressInterests(producer, {
+      "/prefix/a",   // 0: miss, cache [a]
+      "/prefix/b",   // 1: miss, cache [b a]
+      "/prefix/a",   // 2: hit, cache [a b]
+      "/prefix/c",   // 3: miss, evicts b, cache [c a]
+      "/prefix/b",   // 4: miss, evicts a, cache [b c]
+      "/prefix/c",   // 5: hit, cache [c b]
+      "/prefix/a"    // 6: miss, evicts b, cache [a c]
+    });
+  run();
+
+  const auto& data = transmittedData[producer];
+  BOOST_REQUIRE_EQUAL(data.size(), 7);
+
+  BOOST_CHECK(data[2] == data[0]);
+  BOOST_CHECK(data[4] != data[1]);
+  BOOST_CHECK(data[5] == data[3]);
+  BOOST_CHECK(data[6] != data[0]);
+  BOOST_CHECK(data[6] != data[2]);
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    BOOST_CHECK_EQUAL(data[i]->getContent().value_size(), 100);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NoDataCache)
+{
+  Ptr<App> producer = installProducer(false, 0);
+
+  expressInterests(producer, {"/prefix/a", "/prefix/a"});
+  run();
+
+  const auto& data = transmittedData[producer];
+  BOOST_REQUIRE_EQUAL(data.size(), 2);
+  BOOST_CHECK(data[0] != data[1]);
+  BOOST_CHECK_EQUAL(data[0]->wireEncode(), data[1]->wireEncode());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,11 @@
  **/
 
 #include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
+
 #include "../tests-common.hpp"
 
 #include "ns3/point-to-point-module.h"
@@ -62,6 +67,119 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+BOOST_AUTO_TEST_CASE(InstallContainer)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.Install(nodes);
+
+  // all nodes have their stack and faces after a single warmup
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    Ptr<L3Protocol> proto = L3Protocol::getL3Protocol(nodes.Get(i));
+    BOOST_REQUIRE(proto != nullptr);
+    for (uint32_t j = 0; j < nodes.Get(i)->GetNDevices(); ++j) {
+      BOOST_CHECK(proto->getFaceByNetDevice(nodes.Get(i)->GetDevice(j)) != nullptr);
+    }
+  }
+
+  // default routes are registered through the management of each node
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+    Ptr<L3Protocol> proto = L3Protocol::getL3Protocol(nodes.Get(i));
+    const nfd::fib::Entry* entry = proto->getForwarder()->getFib().findExactMatch("/");
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_CHECK_EQUAL(entry->getNextHops().size(), nodes.Get(i)->GetNDevices());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LightweightForwarder)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.setLightweightForwarder(true);
+  ndnHelper.setPolicy("nfd::cs::lru");
+  ndnHelper.Install(nodes.Get(0));
+
+  Ptr<L3Protocol> proto = L3Protocol::getL3Protocol(nodes.Get(0));
+  BOOST_CHECK(proto->isLightweight());
+  BOOST_CHECK(proto->getFibManager() == nullptr);
+  BOOST_CHECK_EQUAL(proto->getForwarder()->getCs().getPolicy()->getName(), "lru");
+  BOOST_CHECK_EQUAL(proto->getForwarder()->getCs().getLimit(), 100);
+
+  // only the content store face of the forwarder and the face to the other node,
+  // no internal face for management
+  BOOST_CHECK_EQUAL(proto->getFaceTable().size(), 2);
+  BOOST_CHECK(proto->getFaceTable().get(nfd::face::FACEID_INTERNAL_FACE) == nullptr);
+
+  // default route is added directly to FIB
+  nfd::Fib& fib = proto->getForwarder()->getFib();
+  BOOST_CHECK_EQUAL(fib.size(), 1);
+  BOOST_CHECK(fib.findExactMatch("/") != nullptr);
+
+  shared_ptr<Face> face = proto->getFaceByNetDevice(nodes.Get(0)->GetDevice(0));
+  BOOST_REQUIRE(face != nullptr);
+  FibHelper::AddRoute(nodes.Get(0), "/prefix", face, 5);
+  nfd::fib::Entry* entry = fib.findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 5);
+
+  FibHelper::RemoveRoute(nodes.Get(0), "/prefix", face);
+  BOOST_CHECK(fib.findExactMatch("/prefix") == nullptr);
+
+  // strategy choice is configured from tables section and modified directly
+  StrategyChoiceHelper::Install(nodes.Get(0), "/prefix", "/localhost/nfd/strategy/multicast");
+  nfd::StrategyChoice& sc = proto->getForwarder()->getStrategyChoice();
+  BOOST_CHECK_EQUAL(sc.findEffectiveStrategy("/prefix/A").getInstanceName().get(3).toUri(),
+                    "multicast");
+  BOOST_CHECK_EQUAL(sc.findEffectiveStrategy("/A").getInstanceName().get(3).toUri(),
+                    "best-route");
+}
+
+BOOST_AUTO_TEST_CASE(DeadNonceFilter)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setDeadNonceFilter(1000, 0.001);
+  ndnHelper.Install(nodes.Get(0));
+
+  // capacity 0 restores the exact storage for subsequently installed nodes
+  ndnHelper.setDeadNonceFilter(0);
+  ndnHelper.Install(nodes.Get(1));
+
+  nfd::DeadNonceList& dnl0 = L3Protocol::getL3Protocol(nodes.Get(0))->getForwarder()
+                               ->getDeadNonceList();
+  BOOST_CHECK(dnl0.isFilterEnabled());
+  dnl0.add("/A", 0x1d2e3f4a);
+  BOOST_CHECK(dnl0.has("/A", 0x1d2e3f4a));
+  BOOST_CHECK_GT(dnl0.getFalsePositiveRate(), 0.0);
+  BOOST_CHECK_LE(dnl0.getFalsePositiveRate(), 0.001);
+
+  nfd::DeadNonceList& dnl1 = L3Protocol::getL3Protocol(nodes.Get(1))->getForwarder()
+                               ->getDeadNonceList();
+  BOOST_CHECK(!dnl1.isFilterEnabled());
+  BOOST_CHECK_EQUAL(dnl1.getFalsePositiveRate(), 0.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -91,6 +91,42 @@ BOOST_AUTO_TEST_CASE(EncodePrintData)
   }
 }
 
+BOOST_AUTO_TEST_CASE(EncodePrintVirtualPayloadData)
+{
+  Data data("/other/prefix");
+  data.setFreshnessPeriod(ndn::time::milliseconds(1000));
+  data.setVirtualContent(1024);
+  ndn::StackHelper::getKeyChain().sign(data);
+  BOOST_CHECK_EQUAL(data.getVirtualContentSize(), 1024);
+
+  lp::Packet lpPacket(data.wireEncode());
+  auto packet(lpPacket.wireEncode());
+  BlockHeader header(packet);
+
+  // same on-the-wire size as Data with materialized 1024-octet payload
+  BOOST_CHECK_LT(header.GetSerializedSize(), 1350);
+  BOOST_CHECK_EQUAL(header.GetSerializedSize() + BlockHeader::getVirtualPayloadPadding(packet), 1350);
+
+  Data materialized("/other/prefix");
+  materialized.setFreshnessPeriod(ndn::time::milliseconds(1000));
+  materialized.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(materialized);
+  BOOST_CHECK_EQUAL(data.wireEncode().size() + BlockHeader::getVirtualPayloadPadding(data.wireEncode()),
+                    materialized.wireEncode().size());
+
+  {
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(header);
+    boost::test_tools::output_test_stream output;
+    packet->Print(output);
+    BOOST_CHECK(output.is_equal("ns3::ndn::Packet (Data: /other/prefix (virtual payload 1024))"));
+  }
+
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  BOOST_CHECK_EQUAL(BlockHeader::getVirtualPayloadPadding(lp::Packet(interest.wireEncode()).wireEncode()), 0);
+}
+
 BOOST_AUTO_TEST_CASE(PrintLpPacket)
 {
   Interest interest("/prefix");
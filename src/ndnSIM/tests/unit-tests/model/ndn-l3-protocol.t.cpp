@@ -19,6 +19,7 @@
 
 #include "helper/ndn-scenario-helper.hpp"
 #include "helper/ndn-app-helper.hpp"
+#include "apps/ndn-app.hpp"
 
 #include <ndn-cxx/face.hpp>
 
@@ -124,6 +125,115 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
 
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+/**
+ * @brief Application that hands Interests to the forwarder on request, outside any event
+ */
+class InterestSenderApp : public App
+{
+public:
+  void
+  sendInterest(const Name& name)
+  {
+    auto interest = make_shared<Interest>(name);
+    interest->setCanBePrefix(false);
+
+    m_transmittedInterests(interest, this, m_face);
+    m_appLink->onReceiveInterest(*interest);
+  }
+};
+
+class AppDispatchFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  setupAndRun(bool isDirect)
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("500p"));
+
+    getStackHelper().setDirectAppDispatch(isDirect);
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/remote", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/remote"}, {"Frequency", "10"}},
+            "0.1s", "1.1s"},
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/local"}, {"Frequency", "10"}},
+            "0.1s", "1.1s"},
+        {"1", "ns3::ndn::Producer",
+            {{"Prefix", "/local"}, {"PayloadSize", "1024"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/remote"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    sender = CreateObject<InterestSenderApp>();
+    getNode("1")->AddApplication(sender);
+
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::App/ReceivedDatas",
+                                  MakeCallback(&AppDispatchFixture::onData, this));
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    receivedData[data->getName().getPrefix(1)].push_back(Simulator::Now());
+  }
+
+public:
+  Ptr<InterestSenderApp> sender;
+  std::map<Name, std::vector<Time>> receivedData;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppDispatch, AppDispatchFixture)
+
+BOOST_AUTO_TEST_CASE(Scheduled)
+{
+  setupAndRun(false);
+
+  BOOST_CHECK_EQUAL(L3Protocol::getL3Protocol(getNode("1"))->isDirectAppDispatch(), false);
+  BOOST_CHECK_EQUAL(receivedData["/remote"].size(), 10);
+  BOOST_CHECK_EQUAL(receivedData["/local"].size(), 10);
+
+  // the simulator is stopped: both the Interest to the producer and the Data back wait for events
+  sender->sendInterest("/local/outside-of-simulation");
+  BOOST_CHECK_EQUAL(receivedData["/local"].size(), 10);
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+  BOOST_REQUIRE_EQUAL(receivedData["/local"].size(), 11);
+  BOOST_CHECK_EQUAL(receivedData["/local"].back(), Seconds(2.0));
+}
+
+BOOST_AUTO_TEST_CASE(Direct)
+{
+  setupAndRun(true);
+
+  BOOST_CHECK_EQUAL(L3Protocol::getL3Protocol(getNode("1"))->isDirectAppDispatch(), true);
+  BOOST_CHECK_EQUAL(receivedData["/remote"].size(), 10);
+  BOOST_CHECK_EQUAL(receivedData["/local"].size(), 10);
+
+  // the simulator is stopped: the producer and the sender are called before sendInterest returns
+  sender->sendInterest("/local/outside-of-simulation");
+  BOOST_REQUIRE_EQUAL(receivedData["/local"].size(), 11);
+  BOOST_CHECK_EQUAL(receivedData["/local"].back(), Seconds(2.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AppDispatch
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-net-device-transport.hpp"
+#include "model/ndn-block-header.hpp"
+
+#include "ns3/ppp-header.h"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class InProcessPacketPassingFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  void
+  setupAndRun(bool isInProcess)
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+    getStackHelper().setInProcessPacketPassing(isInProcess);
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "1s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    getNetDevice("2", "3")->TraceConnectWithoutContext("MacTx",
+      MakeCallback(&InProcessPacketPassingFixture::onMacTx, this));
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+  }
+
+  void
+  onMacTx(Ptr<const Packet> packet)
+  {
+    Ptr<Packet> serialized = NetDeviceTransport::GetSerializedPacket(packet)->Copy();
+    PppHeader ppp;
+    serialized->RemoveHeader(ppp);
+
+    BlockHeader header;
+    serialized->RemoveHeader(header);
+    lp::Packet lpPacket(header.getBlock());
+    if (lpPacket.has<lp::FragmentField>()) {
+      ++nSerializedPackets;
+    }
+  }
+
+public:
+  size_t nSerializedPackets = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnNetDeviceTransport, InProcessPacketPassingFixture)
+
+BOOST_AUTO_TEST_CASE(Serialized)
+{
+  setupAndRun(false);
+
+  auto transport = dynamic_cast<NetDeviceTransport*>(getFace("1", "2")->getTransport());
+  BOOST_REQUIRE(transport != nullptr);
+  BOOST_CHECK_EQUAL(transport->isInProcessPacketPassing(), false);
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nOutInterests, 10);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 10);
+  BOOST_CHECK_EQUAL(nSerializedPackets, 10);
+}
+
+BOOST_AUTO_TEST_CASE(InProcess)
+{
+  setupAndRun(true);
+
+  auto transport = dynamic_cast<NetDeviceTransport*>(getFace("1", "2")->getTransport());
+  BOOST_REQUIRE(transport != nullptr);
+  BOOST_CHECK_EQUAL(transport->isInProcessPacketPassing(), true);
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nOutInterests, 10);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nInData, 10);
+  // pcap-like tracers still can get the wire format
+  BOOST_CHECK_EQUAL(nSerializedPackets, 10);
+}
+
+BOOST_AUTO_TEST_CASE(SameByteCounters)
+{
+  // each run needs its own simulation, hence a separate fixture per mode
+  auto runAndGetByteCounters = [] (bool isInProcess) {
+    InProcessPacketPassingFixture fixture;
+    fixture.setupAndRun(isInProcess);
+    const auto& counters23 = fixture.getFace("2", "3")->getCounters();
+    const auto& counters32 = fixture.getFace("3", "2")->getCounters();
+    return std::vector<uint64_t>{counters23.nOutBytes, counters23.nInBytes,
+                                 counters32.nOutBytes, counters32.nInBytes};
+  };
+
+  std::vector<uint64_t> serialized = runAndGetByteCounters(false);
+  std::vector<uint64_t> inProcess = runAndGetByteCounters(true);
+
+  BOOST_CHECK_NE(serialized[0], 0);
+  BOOST_CHECK_NE(serialized[2], 0);
+  // link-layer sizes are the same as with serialization
+  BOOST_CHECK_EQUAL_COLLECTIONS(inProcess.begin(), inProcess.end(),
+                                serialized.begin(), serialized.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-latency-histogram.hpp"
+
+#include "../tests-common.hpp"
+
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnLatencyHistogram)
+
+BOOST_AUTO_TEST_CASE(Buckets)
+{
+  // exact below 2 * SUB_BUCKETS
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(0), 0);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(63), 63);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(64), 64);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(65), 64);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(127), 95);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(128), 96);
+
+  // buckets are contiguous, and their width is within 1/SUB_BUCKETS of their lower bound
+  for (size_t i = 0; i < 1000; ++i) {
+    uint64_t low = LatencyHistogram::getBucketLowerBound(i);
+    uint64_t high = LatencyHistogram::getBucketUpperBound(i);
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(low), i);
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(high), i);
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketLowerBound(i + 1), high + 1);
+    BOOST_CHECK_LE((high - low) * LatencyHistogram::SUB_BUCKETS, std::max<uint64_t>(low, 1));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Percentiles)
+{
+  LatencyHistogram histogram;
+  for (uint64_t value = 1; value <= 10000; ++value) {
+    histogram.record(value);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 10000);
+  BOOST_CHECK_EQUAL(histogram.getMin(), 1);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 10000);
+  BOOST_CHECK_CLOSE(histogram.getMean(), 5000.5, 0.001);
+
+  BOOST_CHECK_CLOSE(static_cast<double>(histogram.getValueAtPercentile(50)), 5000, 3.2);
+  BOOST_CHECK_CLOSE(static_cast<double>(histogram.getValueAtPercentile(99)), 9900, 3.2);
+  BOOST_CHECK_EQUAL(histogram.getValueAtPercentile(100), 10000);
+  BOOST_CHECK_EQUAL(histogram.getValueAtPercentile(0), 1);
+
+  LatencyHistogram other;
+  other.record(20000);
+  histogram.merge(other);
+  BOOST_CHECK_EQUAL(histogram.getCount(), 10001);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 20000);
+
+  histogram.reset();
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  histogram.record(7);
+  histogram.record(7);
+  histogram.record(100);
+  std::ostringstream os;
+  histogram.printBuckets(os);
+  BOOST_CHECK_EQUAL(os.str(), "7:2;100:1");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
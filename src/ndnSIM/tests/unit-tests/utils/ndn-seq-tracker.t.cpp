@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-seq-tracker.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnSeqTracker)
+
+BOOST_AUTO_TEST_CASE(States)
+{
+  SeqTracker tracker;
+  tracker.setGranularity(MilliSeconds(50));
+
+  tracker.onSent(1, MilliSeconds(0), Seconds(1));
+  tracker.onSent(2, MilliSeconds(10), Seconds(1));
+  tracker.onSent(1, MilliSeconds(20), Seconds(1));
+  BOOST_CHECK_EQUAL(tracker.size(), 2);
+
+  const SeqTracker::State* state = tracker.find(1);
+  BOOST_REQUIRE(state != nullptr);
+  BOOST_CHECK_EQUAL(state->firstSent, MilliSeconds(0));
+  BOOST_CHECK_EQUAL(state->lastSent, MilliSeconds(20));
+  BOOST_CHECK_EQUAL(state->retxCount, 2);
+
+  tracker.erase(1);
+  BOOST_CHECK(tracker.find(1) == nullptr);
+  BOOST_CHECK(tracker.find(2) != nullptr);
+  BOOST_CHECK_EQUAL(tracker.size(), 1);
+
+  // grow past the initial capacity and shrink back
+  for (uint32_t seq = 100; seq < 1100; ++seq) {
+    tracker.onSent(seq, MilliSeconds(30), Seconds(1));
+  }
+  BOOST_CHECK_EQUAL(tracker.size(), 1001);
+  for (uint32_t seq = 100; seq < 1100; seq += 2) {
+    tracker.erase(seq);
+  }
+  BOOST_CHECK_EQUAL(tracker.size(), 501);
+  for (uint32_t seq = 100; seq < 1100; ++seq) {
+    BOOST_CHECK_EQUAL(tracker.find(seq) != nullptr, seq % 2 == 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Timers)
+{
+  SeqTracker tracker(4);
+  tracker.setGranularity(MilliSeconds(50));
+  BOOST_CHECK(!tracker.hasTimers());
+
+  tracker.onSent(1, MilliSeconds(0), MilliSeconds(120));  // tick 3
+  tracker.onSent(2, MilliSeconds(0), MilliSeconds(100));  // tick 2
+  tracker.onSent(3, MilliSeconds(0), MilliSeconds(1000)); // tick 20, same bucket as tick 0
+  tracker.onSent(4, MilliSeconds(0), MilliSeconds(90));   // tick 2
+  BOOST_REQUIRE(tracker.hasTimers());
+  BOOST_CHECK_EQUAL(tracker.getNextExpiry(), MilliSeconds(100));
+
+  // pending timer is not restarted by another transmission
+  tracker.onSent(4, MilliSeconds(10), MilliSeconds(500));
+
+  std::vector<uint32_t> expired;
+  tracker.expire(MilliSeconds(99), expired);
+  BOOST_CHECK(expired.empty());
+
+  tracker.erase(2);
+  tracker.expire(MilliSeconds(100), expired);
+  BOOST_CHECK_EQUAL(expired.size(), 1);
+  BOOST_CHECK_EQUAL(expired.front(), 4);
+  BOOST_REQUIRE(tracker.find(4) != nullptr);
+  BOOST_CHECK_EQUAL(tracker.find(4)->retxCount, 2);
+
+  BOOST_CHECK_EQUAL(tracker.getNextExpiry(), MilliSeconds(150));
+  tracker.erase(1);
+  BOOST_CHECK_EQUAL(tracker.getNextExpiry(), MilliSeconds(1000));
+
+  // retransmission re-arms the timer
+  tracker.onSent(4, MilliSeconds(200), MilliSeconds(100));
+  BOOST_CHECK_EQUAL(tracker.getNextExpiry(), MilliSeconds(300));
+
+  expired.clear();
+  tracker.expire(MilliSeconds(2000), expired);
+  std::vector<uint32_t> expected{4, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expired.begin(), expired.end(), expected.begin(), expected.end());
+  BOOST_CHECK(!tracker.hasTimers());
+  BOOST_CHECK_EQUAL(tracker.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -89,12 +89,12 @@ BOOST_AUTO_TEST_CASE(InstallAll)
 
   BOOST_CHECK_EQUAL(buffer.str(),
                     R"STR(Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount
-1.04177	1	0	0	LastDelay	0.0417664	41766.4	1	2
-1.04177	1	0	0	FullDelay	0.0417664	41766.4	1	2
+1.04186	1	0	0	LastDelay	0.041856	41856	1	2
+1.04186	1	0	0	FullDelay	0.041856	41856	1	2
 2	2	0	0	LastDelay	0	0	1	1
 2	2	0	0	FullDelay	0	0	1	1
-3.02088	2	0	1	LastDelay	0.0208832	20883.2	1	1
-3.02088	2	0	1	FullDelay	0.0208832	20883.2	1	1
+3.02093	2	0	1	LastDelay	0.020928	20928	1	1
+3.02093	2	0	1	FullDelay	0.020928	20928	1	1
 )STR");
 }
 
@@ -116,8 +116,8 @@ BOOST_AUTO_TEST_CASE(InstallNodeContainer)
 
   BOOST_CHECK_EQUAL(buffer.str(),
     R"STR(Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount
-1.04177	1	0	0	LastDelay	0.0417664	41766.4	1	2
-1.04177	1	0	0	FullDelay	0.0417664	41766.4	1	2
+1.04186	1	0	0	LastDelay	0.041856	41856	1	2
+1.04186	1	0	0	FullDelay	0.041856	41856	1	2
 )STR");
 }
 
@@ -138,8 +138,8 @@ BOOST_AUTO_TEST_CASE(InstallNode)
     R"STR(Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount
 2	2	0	0	LastDelay	0	0	1	1
 2	2	0	0	FullDelay	0	0	1	1
-3.02088	2	0	1	LastDelay	0.0208832	20883.2	1	1
-3.02088	2	0	1	FullDelay	0.0208832	20883.2	1	1
+3.02093	2	0	1	LastDelay	0.020928	20928	1	1
+3.02093	2	0	1	FullDelay	0.020928	20928	1	1
 )STR");
 }
 
@@ -156,11 +156,36 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
   BOOST_CHECK(output->is_equal(
     R"STR(2	2	0	0	LastDelay	0	0	1	1
 2	2	0	0	FullDelay	0	0	1	1
-3.02088	2	0	1	LastDelay	0.0208832	20883.2	1	1
-3.02088	2	0	1	FullDelay	0.0208832	20883.2	1	1
+3.02093	2	0	1	LastDelay	0.020928	20928	1	1
+3.02093	2	0	1	FullDelay	0.020928	20928	1	1
 )STR"));
 }
 
+BOOST_AUTO_TEST_CASE(InstallAggregated)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("2"));
+
+  AppDelayTracer::InstallAggregated(nodes, TEST_TRACE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    R"STR(Time,Node,AppId,Prefix,Type,Count,RetxCount,MinUS,P50US,P90US,P99US,P999US,MaxUS,MeanUS,Histogram
+4,2,0,/prefix,LastDelay,2,2,0,0,20927,20927,20927,20927,10463.5,0:1;20480:1
+4,2,0,/prefix,FullDelay,2,2,0,0,20927,20927,20927,20927,10463.5,0:1;20480:1
+4,2,all,/prefix,LastDelay,2,2,0,0,20927,20927,20927,20927,10463.5,0:1;20480:1
+4,2,all,/prefix,FullDelay,2,2,0,0,20927,20927,20927,20927,10463.5,0:1;20480:1
+)STR");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
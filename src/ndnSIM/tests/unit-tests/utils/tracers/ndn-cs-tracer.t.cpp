@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-cs-tracer.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class CsTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  CsTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    createTopology({
+        {"1"},
+        {"2"}
+      });
+
+    // CS operations are invoked directly, so that the expected counts do not depend on forwarding
+    Simulator::Schedule(Seconds(1.1), &CsTracerFixture::insertData, this, "1", "/A", false);
+    Simulator::Schedule(Seconds(1.2), &CsTracerFixture::insertData, this, "1", "/B", true);
+    Simulator::Schedule(Seconds(1.3), &CsTracerFixture::findData, this, "1", "/A"); // hit
+    Simulator::Schedule(Seconds(1.4), &CsTracerFixture::findData, this, "1", "/C"); // miss
+    Simulator::Schedule(Seconds(2.1), &CsTracerFixture::findData, this, "1", "/B"); // agent hit
+    Simulator::Schedule(Seconds(2.2), &CsTracerFixture::insertData, this, "1", "/D", false); // evicts /A
+
+    // NFD management exchanges its commands and their responses through the CS at startup,
+    // tracing begins after they have completed and their Data has been erased
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+
+    nfd::cs::Cs& cs = getCs("1");
+    cs.erase("/", cs.size(), [] (size_t) {});
+    cs.setLimit(2);
+  }
+
+  ~CsTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    CsTracer::Destroy(); // additional cleanup
+  }
+
+  nfd::cs::Cs&
+  getCs(const std::string& node)
+  {
+    return L3Protocol::getL3Protocol(getNode(node))->getForwarder()->getCs();
+  }
+
+  void
+  insertData(const std::string& node, const Name& name, bool isAgent)
+  {
+    auto data = make_shared<Data>(name);
+    ::ndn::Signature signature;
+    signature.setInfo(::ndn::SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)));
+    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+    data->wireEncode();
+
+    getCs(node).insert(*data, false, isAgent);
+  }
+
+  void
+  findData(const std::string& node, const Name& name)
+  {
+    Interest interest(name);
+    interest.setCanBePrefix(false);
+    getCs(node).find(interest, [] (const Interest&, const Data&) {}, [] (const Interest&) {});
+  }
+
+  std::string
+  readTrace()
+  {
+    std::ifstream t(TEST_TRACE.string().c_str());
+    std::stringstream buffer;
+    buffer << t.rdbuf();
+    return buffer.str();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnCsTracer, CsTracerFixture)
+
+BOOST_AUTO_TEST_CASE(InstallAll)
+{
+  CsTracer::InstallAll(TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(2.5)); // until 3.5s
+  Simulator::Run();
+
+  CsTracer::Destroy(); // to force log to be written
+
+  BOOST_CHECK_EQUAL(readTrace(),
+                    R"STR(Time	Node	Type	Packets	
+2	1	CacheHits	1
+2	1	CacheMisses	1
+2	1	CacheInserts	2
+2	1	CacheEvictions	0
+2	1	AgentCacheHits	0
+2	1	AgentCacheInserts	1
+2	1	AgentCacheEvictions	0
+2	2	CacheHits	0
+2	2	CacheMisses	0
+2	2	CacheInserts	0
+2	2	CacheEvictions	0
+2	2	AgentCacheHits	0
+2	2	AgentCacheInserts	0
+2	2	AgentCacheEvictions	0
+3	1	CacheHits	1
+3	1	CacheMisses	0
+3	1	CacheInserts	1
+3	1	CacheEvictions	1
+3	1	AgentCacheHits	1
+3	1	AgentCacheInserts	0
+3	1	AgentCacheEvictions	0
+3	2	CacheHits	0
+3	2	CacheMisses	0
+3	2	CacheInserts	0
+3	2	CacheEvictions	0
+3	2	AgentCacheHits	0
+3	2	AgentCacheInserts	0
+3	2	AgentCacheEvictions	0
+)STR");
+}
+
+BOOST_AUTO_TEST_CASE(InstallNode)
+{
+  CsTracer::Install(getNode("1"), TEST_TRACE.string(), Seconds(2));
+
+  Simulator::Stop(Seconds(2.5)); // until 3.5s
+  Simulator::Run();
+
+  CsTracer::Destroy(); // to force log to be written
+
+  BOOST_CHECK_EQUAL(readTrace(),
+                    R"STR(Time	Node	Type	Packets	
+3	1	CacheHits	2
+3	1	CacheMisses	1
+3	1	CacheInserts	3
+3	1	CacheEvictions	1
+3	1	AgentCacheHits	1
+3	1	AgentCacheInserts	1
+3	1	AgentCacheEvictions	0
+)STR");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
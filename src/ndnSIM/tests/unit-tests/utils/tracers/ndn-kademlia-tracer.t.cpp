@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-kademlia-tracer.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+/** \brief KoNDN scenario with a consumer "C" requesting /prefix from a producer "P"
+ *
+ *  Consumers hash /prefix to b3bc93c2..., and node "D" has the closest ID to it.  Only one
+ *  Interest is sent, so that the hop counts of the trace are those of a single request.
+ */
+class KademliaTracerFixture : public CleanupFixture
+{
+public:
+  KademliaTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+  }
+
+  ~KademliaTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    KademliaTracer::Destroy(); // additional cleanup
+  }
+
+  /** \brief creates nodes with the given IDs, links, routes and applications, and records the
+   *         Kademlia events of the forwarders
+   */
+  void
+  createScenario(std::initializer_list<std::pair<std::string, std::string>> ids,
+                 std::initializer_list<std::pair<std::string, std::string>> links)
+  {
+    for (const auto& id : ids) {
+      Ptr<Node> node = CreateObject<Node>(id.second);
+      Names::Add(id.first, node);
+      nodes.Add(node);
+    }
+
+    PointToPointHelper p2p;
+    for (const auto& link : links) {
+      p2p.Install(Names::Find<Node>(link.first), Names::Find<Node>(link.second));
+    }
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+    StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/kondn/%FD%05");
+
+    GlobalRoutingHelper routingHelper;
+    routingHelper.InstallAll();
+    for (const auto& id : ids) {
+      routingHelper.AddOrigins("/" + id.second, Names::Find<Node>(id.first));
+    }
+    routingHelper.AddOrigins("/prefix", Names::Find<Node>("P"));
+    GlobalRoutingHelper::CalculateRoutes();
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", StringValue("1"));
+    ApplicationContainer consumer = consumerHelper.Install(Names::Find<Node>("C"));
+    consumer.Start(Seconds(0));
+    consumer.Stop(Seconds(0.5)); // send just one Interest
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.Install(Names::Find<Node>("P"));
+
+    for (const auto& id : ids) {
+      connect(id.first);
+    }
+  }
+
+  std::string
+  readTrace()
+  {
+    std::ifstream t(TEST_TRACE.string().c_str());
+    std::stringstream buffer;
+    buffer << t.rdbuf();
+    return buffer.str();
+  }
+
+private:
+  void
+  connect(const std::string& node)
+  {
+    nfd::Forwarder& forwarder = *L3Protocol::getL3Protocol(Names::Find<Node>(node))->getForwarder();
+
+    forwarder.afterKademliaLookupStart.connect([=] (const Interest&) {
+        lookupStarts.push_back(node);
+      });
+    forwarder.afterKademliaIdHop.connect([=] (const Interest& interest, const Name& nextNodeId) {
+        idHops.push_back(node + " " + nextNodeId.toUri());
+        BOOST_CHECK_EQUAL(interest.getDestinationNodeID(), nextNodeId);
+      });
+    forwarder.afterKademliaAgentSwitch.connect([=] (const Interest& interest) {
+        agentSwitches.push_back(node);
+        BOOST_CHECK_EQUAL(interest.getProtocol(), Name("/ndn"));
+      });
+  }
+
+protected:
+  NodeContainer nodes;
+  std::vector<std::string> lookupStarts;  ///< nodes that started a lookup
+  std::vector<std::string> idHops;        ///< nodes and the IDs of their next nodes in ID space
+  std::vector<std::string> agentSwitches; ///< nodes that switched to NDN routing
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnKademliaTracer, KademliaTracerFixture)
+
+BOOST_AUTO_TEST_CASE(IdSpaceLookup)
+{
+  //        +---+     +---+
+  //        | C |-----| P |
+  //        +---+     +---+
+  //          |      /
+  //        +---+---+     +---+
+  //        |   A   |-----| D |
+  //        +-------+     +---+
+  //
+  // C sends the Interest toward D, which is reached through A; A forwards it to P on its
+  // shortest path to /prefix, so the Interest traverses 2 links instead of 1
+  createScenario({{"C", "0000000000000000000000000000000000000000"},
+                  {"A", "d000000000000000000000000000000000000000"},
+                  {"P", "c000000000000000000000000000000000000000"},
+                  {"D", "b000000000000000000000000000000000000000"}},
+                 {{"C", "P"}, {"C", "A"}, {"A", "P"}, {"A", "D"}});
+
+  KademliaTracer::InstallAll(TEST_TRACE.string(), Seconds(3));
+
+  Simulator::Stop(Seconds(3.5));
+  Simulator::Run();
+
+  KademliaTracer::Destroy(); // to force log to be written
+
+  BOOST_CHECK_EQUAL(lookupStarts.size(), 1);
+  BOOST_CHECK_EQUAL(lookupStarts.at(0), "C");
+  BOOST_CHECK_EQUAL(idHops.size(), 1);
+  BOOST_CHECK_EQUAL(idHops.at(0), "C /b000000000000000000000000000000000000000");
+  BOOST_CHECK_EQUAL(agentSwitches.size(), 0);
+
+  BOOST_CHECK_EQUAL(readTrace(),
+                    R"STR(Time	Node	Type	Value
+3	C	Lookups	1
+3	C	Satisfied	1
+3	C	TimedOut	0
+3	C	Retransmitted	0
+3	C	Fallbacks	0
+3	C	FallbackRatio	0
+3	C	IdHops	1
+3	C	KademliaHops	2
+3	C	NdnHops	0
+3	C	PathLength	2
+3	C	ShortestPath	1
+3	C	Stretch	2
+3	C	MaxStretch	2
+)STR");
+}
+
+BOOST_AUTO_TEST_CASE(AgentSwitch)
+{
+  //        +---+     +---+     +---+     +---+
+  //        | D |-----| A |-----| C |-----| P |
+  //        +---+     +---+     +---+     +---+
+  //
+  // C sends the Interest toward D through A, where the only route to /prefix leads back to C:
+  // A switches the Interest to NDN routing and returns it to C, which forwards it to P, so the
+  // Interest traverses 1 link in ID space and 2 links with NDN routing instead of 1
+  createScenario({{"C", "0000000000000000000000000000000000000000"},
+                  {"A", "d000000000000000000000000000000000000000"},
+                  {"P", "c000000000000000000000000000000000000000"},
+                  {"D", "b000000000000000000000000000000000000000"}},
+                 {{"D", "A"}, {"A", "C"}, {"C", "P"}});
+
+  KademliaTracer::InstallAll(TEST_TRACE.string(), Seconds(3));
+
+  Simulator::Stop(Seconds(3.5));
+  Simulator::Run();
+
+  KademliaTracer::Destroy(); // to force log to be written
+
+  BOOST_CHECK_EQUAL(lookupStarts.size(), 1);
+  BOOST_CHECK_EQUAL(idHops.size(), 1);
+  BOOST_CHECK_EQUAL(idHops.at(0), "C /b000000000000000000000000000000000000000");
+  BOOST_CHECK_EQUAL(agentSwitches.size(), 1);
+  BOOST_CHECK_EQUAL(agentSwitches.at(0), "A");
+
+  BOOST_CHECK_EQUAL(readTrace(),
+                    R"STR(Time	Node	Type	Value
+3	C	Lookups	1
+3	C	Satisfied	1
+3	C	TimedOut	0
+3	C	Retransmitted	0
+3	C	Fallbacks	1
+3	C	FallbackRatio	1
+3	C	IdHops	1
+3	C	KademliaHops	1
+3	C	NdnHops	2
+3	C	PathLength	3
+3	C	ShortestPath	1
+3	C	Stretch	3
+3	C	MaxStretch	3
+)STR");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-table-memory-tracer.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class TableMemoryTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TableMemoryTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    createTopology({
+        {"1"},
+        {"2"}
+      });
+
+    Simulator::Schedule(Seconds(0.5), &TableMemoryTracerFixture::insertData, this, "/A");
+    Simulator::Schedule(Seconds(1.5), &TableMemoryTracerFixture::insertData, this, "/B");
+  }
+
+  ~TableMemoryTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    TableMemoryTracer::Destroy(); // additional cleanup
+  }
+
+  nfd::Forwarder&
+  getForwarder(const std::string& node)
+  {
+    return *L3Protocol::getL3Protocol(getNode(node))->getForwarder();
+  }
+
+  void
+  insertData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    ::ndn::Signature signature;
+    signature.setInfo(::ndn::SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)));
+    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+    data->wireEncode();
+
+    getForwarder("1").getCs().insert(*data);
+  }
+
+  /** @brief Append the rows that the tracer is expected to print for @p node at this time
+   */
+  void
+  expectRows(const std::string& node)
+  {
+    nfd::Forwarder& forwarder = getForwarder(node);
+    std::ostringstream os;
+    auto row = [&] (const char* table, size_t nEntries, size_t nBytes) {
+      os << Simulator::Now().ToDouble(Time::S) << "\t" << node << "\t" << table << "\t"
+         << nEntries << "\t" << nBytes << "\n";
+    };
+    row("NameTree", forwarder.getNameTree().size(), forwarder.getNameTree().getMemoryUsage());
+    row("Pit", forwarder.getPit().size(), forwarder.getPit().getMemoryUsage());
+    row("Fib", forwarder.getFib().size(), forwarder.getFib().getMemoryUsage());
+    row("Cs", forwarder.getCs().size(), forwarder.getCs().getMemoryUsage());
+    row("Measurements", forwarder.getMeasurements().size(),
+        forwarder.getMeasurements().getMemoryUsage());
+    row("DeadNonceList", forwarder.getDeadNonceList().size(),
+        forwarder.getDeadNonceList().getMemoryUsage());
+    expected += os.str();
+
+    if (node == "1") {
+      csSizes.push_back(forwarder.getCs().size());
+    }
+  }
+
+  std::string
+  readTrace()
+  {
+    std::ifstream t(TEST_TRACE.string().c_str());
+    std::stringstream buffer;
+    buffer << t.rdbuf();
+    return buffer.str();
+  }
+
+public:
+  std::string expected = "Time\tNode\tTable\tEntries\tBytes\n";
+  std::vector<size_t> csSizes; ///< CS sizes of node 1 at each expected print
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTableMemoryTracer, TableMemoryTracerFixture)
+
+BOOST_AUTO_TEST_CASE(InstallAll)
+{
+  TableMemoryTracer::InstallAll(TEST_TRACE.string(), Seconds(1));
+
+  for (int time = 1; time <= 2; ++time) {
+    Simulator::Schedule(Seconds(time), &TableMemoryTracerFixture::expectRows, this, "1");
+    Simulator::Schedule(Seconds(time), &TableMemoryTracerFixture::expectRows, this, "2");
+  }
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  TableMemoryTracer::Destroy(); // to force log to be written
+
+  BOOST_CHECK_EQUAL(readTrace(), expected);
+
+  // the CS also holds the responses of NFD management, only the growth is known
+  BOOST_REQUIRE_EQUAL(csSizes.size(), 2);
+  BOOST_CHECK_EQUAL(csSizes[1], csSizes[0] + 1);
+}
+
+BOOST_AUTO_TEST_CASE(InstallNode)
+{
+  TableMemoryTracer::Install(getNode("2"), TEST_TRACE.string(), Seconds(2));
+
+  Simulator::Schedule(Seconds(2), &TableMemoryTracerFixture::expectRows, this, "2");
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  TableMemoryTracer::Destroy(); // to force log to be written
+
+  BOOST_CHECK_EQUAL(readTrace(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseStopsPrinting)
+{
+  auto os = make_shared<std::ostringstream>();
+  Ptr<TableMemoryTracer> tracer = TableMemoryTracer::Install(getNode("1"), os, Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+  std::string trace = os->str();
+  BOOST_CHECK_NE(trace, "");
+
+  // the pending print of a released tracer is cancelled
+  tracer = nullptr;
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(os->str(), trace);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
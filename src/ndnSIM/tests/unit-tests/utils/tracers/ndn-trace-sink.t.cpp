@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-sink.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_DIR = boost::filesystem::path(TEST_CONFIG_PATH);
+
+class TraceSinkFixture
+{
+public:
+  TraceSinkFixture()
+  {
+    boost::filesystem::create_directories(TEST_DIR);
+  }
+
+  ~TraceSinkFixture()
+  {
+    boost::filesystem::remove(TEST_DIR / "trace.csv");
+    boost::filesystem::remove(TEST_DIR / "trace.txt.gz");
+  }
+
+  /**
+   * @brief write @p nRows rows through @p os, and return the expected output
+   */
+  std::string
+  writeRows(std::ostream& os, int nRows, char separator)
+  {
+    std::ostringstream expected;
+    for (int i = 0; i < nRows; ++i) {
+      os << i << "\t" << "/prefix/" << i << "\t" << i * 0.5 << "\n";
+      expected << i << separator << "/prefix/" << i << separator << i * 0.5 << "\n";
+    }
+    return expected.str();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceSink, TraceSinkFixture)
+
+BOOST_AUTO_TEST_CASE(Csv)
+{
+  std::string file = (TEST_DIR / "trace.csv").string();
+  shared_ptr<std::ostream> os = TraceSink::Open(file);
+  BOOST_REQUIRE(os != nullptr);
+
+  // several times the size of the buffer
+  std::string expected = writeRows(*os, 300000, ',');
+
+  // flush returns after the output has been written to the file
+  os->flush();
+  std::ifstream before(file.c_str());
+  std::stringstream buffer;
+  buffer << before.rdbuf();
+  BOOST_CHECK(buffer.str() == expected);
+
+  expected += writeRows(*os, 10, ',');
+  os.reset();
+
+  std::ifstream after(file.c_str());
+  buffer.str("");
+  buffer << after.rdbuf();
+  BOOST_CHECK(buffer.str() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(Gzip)
+{
+  std::string file = (TEST_DIR / "trace.txt.gz").string();
+  shared_ptr<std::ostream> os = TraceSink::Open(file);
+  BOOST_REQUIRE(os != nullptr);
+
+  std::string expected = writeRows(*os, 100000, '\t');
+  os.reset();
+
+  boost::iostreams::filtering_istream is;
+  is.push(boost::iostreams::gzip_decompressor());
+  is.push(boost::iostreams::file_source(file, std::ios_base::in | std::ios_base::binary));
+  std::stringstream buffer;
+  buffer << is.rdbuf();
+  BOOST_CHECK(buffer.str() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(OpenFailure)
+{
+  BOOST_CHECK(TraceSink::Open((TEST_DIR / "non-existing" / "trace.txt").string()) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-latency-histogram.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+size_t
+LatencyHistogram::getBucketIndex(uint64_t value)
+{
+  if (value < 2 * SUB_BUCKETS) {
+    return value;
+  }
+
+  int msb = 63 - __builtin_clzll(value);
+  int shift = msb - SUB_BUCKET_BITS;
+  // (value >> shift) is in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+  return (shift + 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+}
+
+uint64_t
+LatencyHistogram::getBucketLowerBound(size_t index)
+{
+  if (index < 2 * SUB_BUCKETS) {
+    return index;
+  }
+
+  int shift = index / SUB_BUCKETS - 1;
+  return (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+}
+
+uint64_t
+LatencyHistogram::getBucketUpperBound(size_t index)
+{
+  return getBucketLowerBound(index + 1) - 1;
+}
+
+void
+LatencyHistogram::record(uint64_t value)
+{
+  size_t index = getBucketIndex(value);
+  if (index >= m_buckets.size()) {
+    m_buckets.resize(index + 1);
+  }
+  ++m_buckets[index];
+
+  if (m_count == 0 || value < m_min) {
+    m_min = value;
+  }
+  if (m_count == 0 || value > m_max) {
+    m_max = value;
+  }
+  ++m_count;
+  m_sum += value;
+}
+
+void
+LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  if (other.m_count == 0) {
+    return;
+  }
+
+  if (other.m_buckets.size() > m_buckets.size()) {
+    m_buckets.resize(other.m_buckets.size());
+  }
+  for (size_t i = 0; i < other.m_buckets.size(); ++i) {
+    m_buckets[i] += other.m_buckets[i];
+  }
+
+  m_min = m_count == 0 ? other.m_min : std::min(m_min, other.m_min);
+  m_max = m_count == 0 ? other.m_max : std::max(m_max, other.m_max);
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+}
+
+void
+LatencyHistogram::reset()
+{
+  std::fill(m_buckets.begin(), m_buckets.end(), 0);
+  m_count = 0;
+  m_min = 0;
+  m_max = 0;
+  m_sum = 0.0;
+}
+
+double
+LatencyHistogram::getMean() const
+{
+  return m_count == 0 ? 0.0 : m_sum / m_count;
+}
+
+uint64_t
+LatencyHistogram::getValueAtPercentile(double percentile) const
+{
+  NS_ASSERT(m_count > 0);
+
+  // rank of the requested value, counting from 1
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count));
+  rank = std::min(std::max<uint64_t>(rank, 1), m_count);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < m_buckets.size(); ++i) {
+    seen += m_buckets[i];
+    if (seen >= rank) {
+      return std::min(getBucketUpperBound(i), m_max);
+    }
+  }
+  return m_max;
+}
+
+void
+LatencyHistogram::printBuckets(std::ostream& os) const
+{
+  bool isFirst = true;
+  for (size_t i = 0; i < m_buckets.size(); ++i) {
+    if (m_buckets[i] == 0) {
+      continue;
+    }
+    if (!isFirst) {
+      os << ";";
+    }
+    os << getBucketLowerBound(i) << ":" << m_buckets[i];
+    isFirst = false;
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_LATENCY_HISTOGRAM_HPP
+#define NDNSIM_UTILS_NDN_LATENCY_HISTOGRAM_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Log-linear histogram of non-negative integer values (e.g., delays in microseconds)
+ *
+ * Values below 2 * SUB_BUCKETS are counted exactly.  Each larger power-of-two range is split
+ * into SUB_BUCKETS equal buckets, so recorded values and reported percentiles are within
+ * 1/SUB_BUCKETS (about 3%) of the actual value, regardless of its magnitude.  Recording
+ * a value is a few integer operations, and buckets are allocated up to the largest value seen.
+ */
+class LatencyHistogram {
+public:
+  static const int SUB_BUCKET_BITS = 5;
+  static const uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+  void
+  record(uint64_t value);
+
+  /**
+   * @brief Add all values recorded in @p other
+   */
+  void
+  merge(const LatencyHistogram& other);
+
+  void
+  reset();
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  /**
+   * @pre getCount() > 0
+   */
+  uint64_t
+  getMin() const
+  {
+    return m_min;
+  }
+
+  /**
+   * @pre getCount() > 0
+   */
+  uint64_t
+  getMax() const
+  {
+    return m_max;
+  }
+
+  double
+  getMean() const;
+
+  /**
+   * @brief Get the value below which @p percentile percent of recorded values fall
+   *
+   * The result is the upper bound of the bucket containing that value, capped at getMax().
+   * @pre getCount() > 0
+   */
+  uint64_t
+  getValueAtPercentile(double percentile) const;
+
+  /**
+   * @brief Write non-empty buckets as "lowerBound:count" pairs separated by ';'
+   */
+  void
+  printBuckets(std::ostream& os) const;
+
+  static size_t
+  getBucketIndex(uint64_t value);
+
+  static uint64_t
+  getBucketLowerBound(size_t index);
+
+  static uint64_t
+  getBucketUpperBound(size_t index);
+
+private:
+  std::vector<uint64_t> m_buckets;
+  uint64_t m_count = 0;
+  uint64_t m_min = 0;
+  uint64_t m_max = 0;
+  double m_sum = 0.0;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,291 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-seq-tracker.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+static const int64_t FREE_SLOT = -2;
+static const int64_t NO_TIMER = -1;
+static const size_t MIN_CAPACITY = 16;
+
+SeqTracker::SeqTracker(size_t nBuckets)
+  : m_size(0)
+  , m_nTimers(0)
+  , m_granularity(1)
+  , m_lastTick(-1)
+  , m_nextTick(0)
+  , m_isNextTickExact(false)
+{
+  size_t n = 1;
+  while (n < nBuckets) {
+    n <<= 1;
+  }
+  m_buckets.resize(n);
+  rehash(MIN_CAPACITY);
+}
+
+void
+SeqTracker::setGranularity(Time granularity)
+{
+  int64_t newGranularity = std::max<int64_t>(granularity.GetTimeStep(), 1);
+  if (newGranularity == m_granularity) {
+    return;
+  }
+
+  m_lastTick = m_lastTick < 0 ? m_lastTick : m_lastTick * m_granularity / newGranularity;
+  m_granularity = newGranularity;
+
+  for (auto& bucket : m_buckets) {
+    bucket.clear();
+  }
+  m_nTimers = 0;
+  m_isNextTickExact = false;
+
+  for (State& state : m_states) {
+    if (state.timerTick >= 0) {
+      armTimer(state);
+    }
+  }
+}
+
+Time
+SeqTracker::getGranularity() const
+{
+  return TimeStep(m_granularity);
+}
+
+void
+SeqTracker::onSent(uint32_t seq, Time now, Time timeout)
+{
+  if ((m_size + 1) * 2 > m_states.size()) {
+    rehash(m_states.size() * 2);
+  }
+
+  State* state = &m_states[getSlot(seq)];
+  for (size_t mask = m_states.size() - 1; state->timerTick != FREE_SLOT && state->seq != seq;) {
+    state = &m_states[(state - m_states.data() + 1) & mask];
+  }
+
+  if (state->timerTick == FREE_SLOT) {
+    *state = State{seq, now, now, 0, Time(), NO_TIMER, 0};
+    ++m_size;
+  }
+
+  state->lastSent = now;
+  ++state->retxCount;
+
+  if (state->timerTick == NO_TIMER) {
+    state->expiry = now + timeout;
+    armTimer(*state);
+  }
+}
+
+const SeqTracker::State*
+SeqTracker::find(uint32_t seq) const
+{
+  return const_cast<SeqTracker*>(this)->findState(seq);
+}
+
+void
+SeqTracker::erase(uint32_t seq)
+{
+  State* state = findState(seq);
+  if (state == nullptr) {
+    return;
+  }
+
+  if (state->timerTick >= 0) {
+    disarmTimer(*state);
+  }
+  state->timerTick = FREE_SLOT;
+  --m_size;
+
+  // backward shift deletion keeps probe sequences of the remaining entries intact
+  size_t mask = m_states.size() - 1;
+  size_t hole = state - m_states.data();
+  for (size_t i = (hole + 1) & mask; m_states[i].timerTick != FREE_SLOT; i = (i + 1) & mask) {
+    size_t home = getSlot(m_states[i].seq);
+    bool isInPlace = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+    if (!isInPlace) {
+      m_states[hole] = m_states[i];
+      m_states[i].timerTick = FREE_SLOT;
+      hole = i;
+    }
+  }
+}
+
+void
+SeqTracker::expire(Time now, std::vector<uint32_t>& expired)
+{
+  int64_t nowTick = now.GetTimeStep() / m_granularity;
+  if (nowTick <= m_lastTick) {
+    return;
+  }
+
+  size_t first = expired.size();
+  int64_t nTicks = std::min<int64_t>(nowTick - m_lastTick, m_buckets.size());
+  for (int64_t tick = m_lastTick + 1; tick <= m_lastTick + nTicks; ++tick) {
+    std::vector<Timer>& bucket = m_buckets[tick & (m_buckets.size() - 1)];
+    for (size_t i = 0; i < bucket.size();) {
+      if (bucket[i].tick <= nowTick) {
+        // disarming moves the last timer of the bucket into position i
+        expired.push_back(bucket[i].seq);
+        disarmTimer(*findState(bucket[i].seq));
+      }
+      else {
+        ++i;
+      }
+    }
+  }
+  m_lastTick = nowTick;
+
+  std::sort(expired.begin() + first, expired.end(), [this] (uint32_t a, uint32_t b) {
+      Time expiryA = findState(a)->expiry;
+      Time expiryB = findState(b)->expiry;
+      return expiryA < expiryB || (expiryA == expiryB && a < b);
+    });
+}
+
+Time
+SeqTracker::getNextExpiry()
+{
+  NS_ASSERT(hasTimers());
+
+  if (!m_isNextTickExact || m_nextTick <= m_lastTick) {
+    // buckets are visited in the tick order, so the first timer of the current revolution wins
+    int64_t nextTick = std::numeric_limits<int64_t>::max();
+    for (size_t i = 1; i <= m_buckets.size(); ++i) {
+      int64_t tick = m_lastTick + i;
+      for (const Timer& timer : m_buckets[tick & (m_buckets.size() - 1)]) {
+        nextTick = std::min(nextTick, timer.tick);
+      }
+      if (nextTick == tick) {
+        break;
+      }
+    }
+    m_nextTick = nextTick;
+    m_isNextTickExact = true;
+  }
+
+  return TimeStep(m_nextTick * m_granularity);
+}
+
+void
+SeqTracker::clear()
+{
+  for (auto& bucket : m_buckets) {
+    bucket.clear();
+  }
+  m_nTimers = 0;
+  m_isNextTickExact = false;
+
+  m_size = 0;
+  rehash(MIN_CAPACITY);
+}
+
+size_t
+SeqTracker::getSlot(uint32_t seq) const
+{
+  return static_cast<uint32_t>(seq * 2654435761u) & (m_states.size() - 1);
+}
+
+SeqTracker::State*
+SeqTracker::findState(uint32_t seq)
+{
+  size_t mask = m_states.size() - 1;
+  for (size_t i = getSlot(seq); m_states[i].timerTick != FREE_SLOT; i = (i + 1) & mask) {
+    if (m_states[i].seq == seq) {
+      return &m_states[i];
+    }
+  }
+  return nullptr;
+}
+
+void
+SeqTracker::rehash(size_t capacity)
+{
+  std::vector<State> states(std::max(capacity, MIN_CAPACITY));
+  for (State& state : states) {
+    state.timerTick = FREE_SLOT;
+  }
+  m_states.swap(states);
+
+  size_t mask = m_states.size() - 1;
+  for (const State& state : states) {
+    if (state.timerTick != FREE_SLOT) {
+      size_t i = getSlot(state.seq);
+      while (m_states[i].timerTick != FREE_SLOT) {
+        i = (i + 1) & mask;
+      }
+      m_states[i] = state;
+    }
+  }
+}
+
+void
+SeqTracker::armTimer(State& state)
+{
+  int64_t tick = std::max(getTick(state.expiry), m_lastTick + 1);
+  std::vector<Timer>& bucket = m_buckets[tick & (m_buckets.size() - 1)];
+
+  state.timerTick = tick;
+  state.timerIndex = bucket.size();
+  bucket.push_back(Timer{state.seq, tick});
+
+  if (m_nTimers == 0 || tick < m_nextTick) {
+    m_nextTick = tick;
+    m_isNextTickExact = true;
+  }
+  ++m_nTimers;
+}
+
+void
+SeqTracker::disarmTimer(State& state)
+{
+  std::vector<Timer>& bucket = m_buckets[state.timerTick & (m_buckets.size() - 1)];
+  NS_ASSERT(bucket[state.timerIndex].seq == state.seq);
+
+  if (state.timerIndex + 1 != bucket.size()) {
+    bucket[state.timerIndex] = bucket.back();
+    findState(bucket[state.timerIndex].seq)->timerIndex = state.timerIndex;
+  }
+  bucket.pop_back();
+
+  if (state.timerTick == m_nextTick) {
+    m_isNextTickExact = false;
+  }
+  state.timerTick = NO_TIMER;
+  --m_nTimers;
+}
+
+int64_t
+SeqTracker::getTick(Time time) const
+{
+  return (time.GetTimeStep() + m_granularity - 1) / m_granularity;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_SEQ_TRACKER_HPP
+#define NDNSIM_UTILS_NDN_SEQ_TRACKER_HPP
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Per-sequence-number bookkeeping of consumer applications
+ *
+ * Sequence number states are kept in a flat open-addressing table, and retransmission timers
+ * are kept in a hashed timing wheel with buckets of RetxTimer granularity.  Once the table and
+ * the buckets have grown to the number of outstanding Interests, tracking an Interest does not
+ * allocate memory, and the owner needs to schedule a simulator event only for the earliest
+ * armed timer (see getNextExpiry()).
+ */
+class SeqTracker {
+public:
+  /**
+   * @brief State of a requested sequence number
+   */
+  struct State {
+    uint32_t seq;
+    Time firstSent;      ///< @brief time when the first Interest was sent
+    Time lastSent;       ///< @brief time when the last (re)transmitted Interest was sent
+    uint32_t retxCount;  ///< @brief number of transmitted Interests
+    Time expiry;         ///< @brief time of retransmission timeout, if timer is armed
+    int64_t timerTick;   ///< @brief timing wheel tick of the armed timer, or -1
+    uint32_t timerIndex; ///< @brief position of the timer in its timing wheel bucket
+  };
+
+  explicit
+  SeqTracker(size_t nBuckets = 256);
+
+  /**
+   * @brief Set granularity of the timing wheel
+   *
+   * Already armed timers are moved to the corresponding new ticks.
+   */
+  void
+  setGranularity(Time granularity);
+
+  Time
+  getGranularity() const;
+
+  /**
+   * @brief Record transmission of an Interest for @p seq at @p now
+   *
+   * The retransmission timer is armed to expire at @p now + @p timeout, unless a timer
+   * for @p seq is already pending.
+   */
+  void
+  onSent(uint32_t seq, Time now, Time timeout);
+
+  /**
+   * @return state of @p seq, or nullptr if @p seq is not tracked
+   * @note the pointer is invalidated by subsequent onSent() and erase()
+   */
+  const State*
+  find(uint32_t seq) const;
+
+  /**
+   * @brief Stop tracking @p seq and cancel its timer, if any
+   */
+  void
+  erase(uint32_t seq);
+
+  /**
+   * @brief Disarm the timers that expired at or before @p now
+   *
+   * States of expired sequence numbers are retained.
+   *
+   * @param[out] expired sequence numbers in the order of their expiration
+   */
+  void
+  expire(Time now, std::vector<uint32_t>& expired);
+
+  /**
+   * @brief Time of the earliest timing wheel tick that may have an expired timer
+   * @pre hasTimers()
+   */
+  Time
+  getNextExpiry();
+
+  bool
+  hasTimers() const
+  {
+    return m_nTimers > 0;
+  }
+
+  /**
+   * @return number of tracked sequence numbers
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  void
+  clear();
+
+private:
+  struct Timer {
+    uint32_t seq;
+    int64_t tick;
+  };
+
+  size_t
+  getSlot(uint32_t seq) const;
+
+  State*
+  findState(uint32_t seq);
+
+  void
+  rehash(size_t capacity);
+
+  void
+  armTimer(State& state);
+
+  void
+  disarmTimer(State& state);
+
+  int64_t
+  getTick(Time time) const;
+
+private:
+  std::vector<State> m_states; ///< @brief open-addressing table, timerTick == -2 marks free slots
+  size_t m_size;
+
+  std::vector<std::vector<Timer>> m_buckets;
+  size_t m_nTimers;
+  int64_t m_granularity;  ///< @brief timing wheel tick duration in time steps
+  int64_t m_lastTick;     ///< @brief last tick that has been expired
+  int64_t m_nextTick;     ///< @brief lower bound of ticks of all armed timers
+  bool m_isNextTickExact; ///< @brief whether m_nextTick is known to have an armed timer
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_SEQ_TRACKER_HPP
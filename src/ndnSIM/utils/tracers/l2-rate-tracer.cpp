@@ -18,6 +18,7 @@
  **/
 
 #include "l2-rate-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -29,7 +30,6 @@
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
-#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("L2RateTracer");
 
@@ -48,20 +48,9 @@ void
 L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L2RateTracer>> tracers;
-  std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  std::shared_ptr<std::ostream> outputStream = ndn::TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-app-delay-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -28,11 +29,11 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#include "ns3/string.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
-#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
@@ -45,6 +46,14 @@ static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTrac
 void
 AppDelayTracer::Destroy()
 {
+  // aggregated output would otherwise be written only on Simulator::Destroy
+  for (const auto& group : g_tracers) {
+    for (const Ptr<AppDelayTracer>& tracer : std::get<1>(group)) {
+      if (tracer->m_isAggregating) {
+        tracer->FinalPrinter();
+      }
+    }
+  }
   g_tracers.clear();
 }
 
@@ -55,20 +64,9 @@ AppDelayTracer::InstallAll(const std::string& file)
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
@@ -92,20 +90,9 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
@@ -129,20 +116,9 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   Ptr<AppDelayTracer> trace = Install(node, outputStream);
@@ -167,6 +143,40 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
   return trace;
 }
 
+void
+AppDelayTracer::InstallAllAggregated(const std::string& file, Time period /* = Seconds(0)*/)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+  InstallAggregated(nodes, file, period);
+}
+
+void
+AppDelayTracer::InstallAggregated(const NodeContainer& nodes, const std::string& file,
+                                  Time period /* = Seconds(0)*/)
+{
+  std::list<Ptr<AppDelayTracer>> tracers;
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    trace->EnableAggregation(period);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintAggregatedHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -174,6 +184,7 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_isAggregating(false)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,11 +199,15 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_isAggregating(false)
 {
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+}
 
 void
 AppDelayTracer::Connect()
@@ -230,10 +245,122 @@ AppDelayTracer::PrintHeader(std::ostream& os) const
      << "";
 }
 
+void
+AppDelayTracer::EnableAggregation(Time period)
+{
+  m_isAggregating = true;
+  m_period = period;
+
+  m_printEvent.Cancel();
+  if (!m_period.IsZero()) {
+    m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+  }
+  // the tracer is kept alive until the final output is written
+  Simulator::ScheduleDestroy(&AppDelayTracer::FinalPrinter, Ptr<AppDelayTracer>(this));
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  PrintAggregated(*m_os);
+  ResetAggregated();
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::FinalPrinter()
+{
+  m_printEvent.Cancel();
+  PrintAggregated(*m_os);
+  ResetAggregated();
+  m_os->flush();
+}
+
+void
+AppDelayTracer::ResetAggregated()
+{
+  for (auto& i : m_appStats) {
+    i.second.lastDelay.reset();
+    i.second.fullDelay.reset();
+    i.second.nRetx = 0;
+  }
+  for (auto& i : m_prefixStats) {
+    i.second.lastDelay.reset();
+    i.second.fullDelay.reset();
+    i.second.nRetx = 0;
+  }
+}
+
+AppDelayTracer::DelayStats&
+AppDelayTracer::GetAppStats(Ptr<App> app)
+{
+  auto i = m_appStats.find(app->GetId());
+  if (i != m_appStats.end()) {
+    return i->second;
+  }
+
+  DelayStats& stats = m_appStats[app->GetId()];
+  StringValue prefix;
+  if (app->GetAttributeFailSafe("Prefix", prefix)) {
+    stats.prefix = prefix.Get();
+  }
+  stats.prefixStats = &m_prefixStats[stats.prefix];
+  stats.prefixStats->prefix = stats.prefix;
+  return stats;
+}
+
+void
+AppDelayTracer::PrintAggregatedHeader(std::ostream& os) const
+{
+  os << "Time,Node,AppId,Prefix,Type,Count,RetxCount,"
+     << "MinUS,P50US,P90US,P99US,P999US,MaxUS,MeanUS,Histogram";
+}
+
+void
+AppDelayTracer::PrintStats(std::ostream& os, const std::string& appId,
+                           const DelayStats& stats) const
+{
+  auto printHistogram = [&] (const char* type, const LatencyHistogram& histogram, uint64_t nRetx) {
+    if (histogram.getCount() == 0) {
+      return;
+    }
+    os << Simulator::Now().ToDouble(Time::S) << "," << m_node << "," << appId << ","
+       << stats.prefix << "," << type << "," << histogram.getCount() << "," << nRetx << ","
+       << histogram.getMin() << "," << histogram.getValueAtPercentile(50) << ","
+       << histogram.getValueAtPercentile(90) << "," << histogram.getValueAtPercentile(99) << ","
+       << histogram.getValueAtPercentile(99.9) << "," << histogram.getMax() << ","
+       << histogram.getMean() << ",";
+    histogram.printBuckets(os);
+    os << "\n";
+  };
+
+  printHistogram("LastDelay", stats.lastDelay, stats.lastDelay.getCount());
+  printHistogram("FullDelay", stats.fullDelay, stats.nRetx);
+}
+
+void
+AppDelayTracer::PrintAggregated(std::ostream& os) const
+{
+  for (const auto& i : m_appStats) {
+    PrintStats(os, boost::lexical_cast<std::string>(i.first), i.second);
+  }
+  for (const auto& i : m_prefixStats) {
+    PrintStats(os, "all", i.second);
+  }
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (m_isAggregating) {
+    DelayStats& stats = GetAppStats(app);
+    stats.lastDelay.record(std::max<int64_t>(delay.GetMicroSeconds(), 0));
+    stats.prefixStats->lastDelay.record(std::max<int64_t>(delay.GetMicroSeconds(), 0));
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +372,15 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (m_isAggregating) {
+    DelayStats& stats = GetAppStats(app);
+    stats.fullDelay.record(std::max<int64_t>(delay.GetMicroSeconds(), 0));
+    stats.nRetx += retxCount;
+    stats.prefixStats->fullDelay.record(std::max<int64_t>(delay.GetMicroSeconds(), 0));
+    stats.prefixStats->nRetx += retxCount;
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
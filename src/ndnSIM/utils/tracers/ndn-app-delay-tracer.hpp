@@ -21,6 +21,7 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-latency-histogram.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -30,6 +31,7 @@
 
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -43,6 +45,11 @@ class App;
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * By default, the tracer writes one line per satisfied Interest.  Tracers installed with
+ * InstallAllAggregated() or InstallAggregated() instead keep log-linear delay histograms
+ * (see LatencyHistogram) per application and per application prefix, and write percentiles
+ * and histograms as CSV periodically and when the simulator is destroyed.
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
@@ -91,6 +98,28 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install aggregating tracers on all simulation nodes
+   *
+   * @param file File to which CSV will be written.  If filename is -, then std::out is used
+   * @param period How often histograms will be written and reset.  If zero (default),
+   *        histograms cover the whole simulation and are written once, on Simulator::Destroy
+   */
+  static void
+  InstallAllAggregated(const std::string& file, Time period = Seconds(0));
+
+  /**
+   * @brief Helper method to install aggregating tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which CSV will be written.  If filename is -, then std::out is used
+   * @param period How often histograms will be written and reset, zero to write them once
+   *        on Simulator::Destroy
+   */
+  static void
+  InstallAggregated(const NodeContainer& nodes, const std::string& file,
+                    Time period = Seconds(0));
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -127,10 +156,55 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Print head of the aggregated CSV
+   */
+  void
+  PrintAggregatedHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print percentiles and histograms of delays recorded since the last reset
+   *
+   * Delays are in microseconds.  RetxCount is the total number of transmitted Interests
+   * for FullDelay, and the number of samples for LastDelay.  Histogram column lists non-empty
+   * buckets as "lowerBound:count" pairs separated by ';'.
+   */
+  void
+  PrintAggregated(std::ostream& os) const;
+
 private:
   void
   Connect();
 
+  /**
+   * @brief Switch from per-packet output to aggregation
+   */
+  void
+  EnableAggregation(Time period);
+
+  void
+  PeriodicPrinter();
+
+  void
+  FinalPrinter();
+
+  void
+  ResetAggregated();
+
+  struct DelayStats {
+    std::string prefix;
+    LatencyHistogram lastDelay;
+    LatencyHistogram fullDelay;
+    uint64_t nRetx = 0;
+    DelayStats* prefixStats = nullptr; ///< @brief stats of the app's prefix
+  };
+
+  DelayStats&
+  GetAppStats(Ptr<App> app);
+
+  void
+  PrintStats(std::ostream& os, const std::string& appId, const DelayStats& stats) const;
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -143,6 +217,12 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+
+  bool m_isAggregating;
+  Time m_period;
+  EventId m_printEvent;
+  std::map<uint32_t, DelayStats> m_appStats;
+  std::map<std::string, DelayStats> m_prefixStats;
 };
 
 } // namespace ndn
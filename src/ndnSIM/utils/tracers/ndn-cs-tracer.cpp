@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-cs-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -25,13 +26,15 @@
 #include "ns3/callback.h"
 
 #include "apps/ndn-app.hpp"
+#include "model/ndn-l3-protocol.hpp"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
 #include <boost/lexical_cast.hpp>
 
-#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
@@ -53,20 +56,9 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
@@ -91,20 +83,9 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
@@ -129,20 +110,9 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
   using namespace std;
 
   std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
@@ -176,6 +146,7 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_cs(nullptr)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -189,7 +160,9 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
   , m_os(os)
+  , m_cs(nullptr)
 {
   Connect();
 }
@@ -199,10 +172,13 @@ CsTracer::~CsTracer(){};
 void
 CsTracer::Connect()
 {
-  // // @TODO Do the same with NFD content store...
-  // Ptr<ContentStore> cs = m_nodePtr->GetObject<ContentStore>();
-  // cs->TraceConnectWithoutContext("CacheHits", MakeCallback(&CsTracer::CacheHits, this));
-  // cs->TraceConnectWithoutContext("CacheMisses", MakeCallback(&CsTracer::CacheMisses, this));
+  Ptr<L3Protocol> ndn = m_nodePtr != nullptr ? m_nodePtr->GetObject<L3Protocol>() : nullptr;
+  if (ndn == nullptr) {
+    NS_LOG_WARN("NDN stack is not installed on node " << m_node << ", CS is not traced");
+  }
+  else {
+    m_cs = &ndn->getForwarder()->getCs();
+  }
 
   Reset();
 }
@@ -239,35 +215,46 @@ CsTracer::PrintHeader(std::ostream& os) const
      << "\t";
 }
 
+cs::Stats
+CsTracer::GetCounters() const
+{
+  cs::Stats stats;
+  if (m_cs != nullptr) {
+    const nfd::cs::Cs::Counters& counters = m_cs->getCounters();
+    stats.m_cacheHits = counters.nHits;
+    stats.m_cacheMisses = counters.nMisses;
+    stats.m_cacheInserts = counters.nInserts;
+    stats.m_cacheEvictions = counters.nEvictions;
+    stats.m_agentCacheHits = counters.nAgentHits;
+    stats.m_agentCacheInserts = counters.nAgentInserts;
+    stats.m_agentCacheEvictions = counters.nAgentEvictions;
+  }
+  return stats;
+}
+
 void
 CsTracer::Reset()
 {
-  m_stats.Reset();
+  m_lastStats = GetCounters();
 }
 
 #define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t"                    \
+     << stats.fieldName - m_lastStats.fieldName << "\n";
 
 void
 CsTracer::Print(std::ostream& os) const
 {
   Time time = Simulator::Now();
+  cs::Stats stats = GetCounters();
 
   PRINTER("CacheHits", m_cacheHits);
   PRINTER("CacheMisses", m_cacheMisses);
-}
-
-void
-CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
-{
-  m_stats.m_cacheHits++;
-}
-
-void
-CsTracer::CacheMisses(shared_ptr<const Interest>)
-{
-  m_stats.m_cacheMisses++;
+  PRINTER("CacheInserts", m_cacheInserts);
+  PRINTER("CacheEvictions", m_cacheEvictions);
+  PRINTER("AgentCacheHits", m_agentCacheHits);
+  PRINTER("AgentCacheInserts", m_agentCacheInserts);
+  PRINTER("AgentCacheEvictions", m_agentCacheEvictions);
 }
 
 } // namespace ndn
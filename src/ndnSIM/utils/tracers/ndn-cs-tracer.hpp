@@ -32,6 +32,12 @@
 #include <map>
 #include <list>
 
+namespace nfd {
+namespace cs {
+class Cs;
+} // namespace cs
+} // namespace nfd
+
 namespace ns3 {
 
 class Node;
@@ -43,21 +49,24 @@ namespace cs {
 
 /// @cond include_hidden
 struct Stats {
-  inline void
-  Reset()
-  {
-    m_cacheHits = 0;
-    m_cacheMisses = 0;
-  }
-  double m_cacheHits;
-  double m_cacheMisses;
+  uint64_t m_cacheHits = 0;
+  uint64_t m_cacheMisses = 0;
+  uint64_t m_cacheInserts = 0;
+  uint64_t m_cacheEvictions = 0;
+  uint64_t m_agentCacheHits = 0;
+  uint64_t m_agentCacheInserts = 0;
+  uint64_t m_agentCacheEvictions = 0;
 };
 /// @endcond
 }
 
 /**
  * @ingroup ndn-tracers
- * @brief NDN tracer for cache performance (hits and misses)
+ * @brief NDN tracer for cache performance (hits, misses, inserts, and evictions)
+ *
+ * The tracer does not connect to any trace source.  Instead, it periodically reads the counters
+ * that nfd::cs::Cs maintains, and prints the increments since the previous period, in total and
+ * for entries cached on behalf of an agent node.
  */
 class CsTracer : public SimpleRefCount<CsTracer> {
 public:
@@ -172,11 +181,11 @@ private:
   void
   Connect();
 
-  void
-  CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>);
-
-  void
-  CacheMisses(shared_ptr<const Interest>);
+  /**
+   * @brief Read current values of the Content Store counters
+   */
+  cs::Stats
+  GetCounters() const;
 
 private:
   void
@@ -196,7 +205,8 @@ private:
 
   Time m_period;
   EventId m_printEvent;
-  cs::Stats m_stats;
+  const nfd::cs::Cs* m_cs;
+  cs::Stats m_lastStats; ///< @brief counter values at the end of the previous period
 };
 
 /**
@@ -0,0 +1,420 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-kademlia-tracer.hpp"
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+#include "ns3/channel.h"
+#include "ns3/net-device.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "daemon/table/pit-entry.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.KademliaTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<KademliaTracer>>>> g_tracers;
+
+namespace kademlia {
+
+/**
+ * @brief Progress of a request, from the lookup start on the consumer node
+ */
+struct Request {
+  KademliaTracer* consumer;
+  uint32_t idHops;
+  uint32_t kademliaHops;
+  uint32_t ndnHops;
+  bool isFallback;
+  int32_t dataSource; ///< @brief node that returned Data, or -1
+};
+
+} // namespace kademlia
+
+/// @brief requests of all nodes, by Nonce
+static std::unordered_map<uint32_t, kademlia::Request> g_requests;
+
+/// @brief hop counts from a node to all other nodes, by source node
+static std::unordered_map<uint32_t, std::vector<int32_t>> g_distances;
+
+static const Name KADEMLIA_PROTOCOL("/kademlia");
+
+/**
+ * @brief Shortest-path hop count between two nodes, or -1 if @p to is unreachable
+ */
+static int32_t
+GetDistance(uint32_t from, uint32_t to)
+{
+  auto i = g_distances.find(from);
+  if (i == g_distances.end()) {
+    std::vector<int32_t>& distances = g_distances[from];
+    distances.assign(NodeList::GetNNodes(), -1);
+    distances[from] = 0;
+
+    std::deque<uint32_t> queue{from};
+    while (!queue.empty()) {
+      Ptr<Node> node = NodeList::GetNode(queue.front());
+      queue.pop_front();
+
+      for (uint32_t dev = 0; dev < node->GetNDevices(); ++dev) {
+        Ptr<Channel> channel = node->GetDevice(dev)->GetChannel();
+        if (channel == nullptr) {
+          continue;
+        }
+        for (uint32_t peer = 0; peer < channel->GetNDevices(); ++peer) {
+          uint32_t neighbor = channel->GetDevice(peer)->GetNode()->GetId();
+          if (distances[neighbor] < 0) {
+            distances[neighbor] = distances[node->GetId()] + 1;
+            queue.push_back(neighbor);
+          }
+        }
+      }
+    }
+    i = g_distances.find(from);
+  }
+
+  return to < i->second.size() ? i->second[to] : -1;
+}
+
+void
+KademliaTracer::Destroy()
+{
+  g_requests.clear();
+  g_distances.clear();
+  g_tracers.clear();
+}
+
+void
+KademliaTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  std::list<Ptr<KademliaTracer>> tracers;
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<KademliaTracer> trace = Install(*node, outputStream, averagingPeriod);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+KademliaTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  std::list<Ptr<KademliaTracer>> tracers;
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<KademliaTracer> trace = Install(*node, outputStream, averagingPeriod);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+Ptr<KademliaTracer>
+KademliaTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                        Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<KademliaTracer> trace = Create<KademliaTracer>(outputStream, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+KademliaTracer::KademliaTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+  , m_isConsumer(false)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+KademliaTracer::~KademliaTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+KademliaTracer::Connect()
+{
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+
+  l3->TraceConnectWithoutContext("KademliaLookupStarts",
+                                 MakeCallback(&KademliaTracer::LookupStart, this));
+  l3->TraceConnectWithoutContext("KademliaIdHops", MakeCallback(&KademliaTracer::IdHop, this));
+  l3->TraceConnectWithoutContext("KademliaAgentSwitches",
+                                 MakeCallback(&KademliaTracer::AgentSwitch, this));
+  l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&KademliaTracer::OutInterests, this));
+  l3->TraceConnectWithoutContext("CsHits", MakeCallback(&KademliaTracer::CsHits, this));
+
+  l3->TraceConnectWithoutContext("SatisfiedInterests",
+                                 MakeCallback(&KademliaTracer::SatisfiedInterests, this));
+  l3->TraceConnectWithoutContext("TimedOutInterests",
+                                 MakeCallback(&KademliaTracer::TimedOutInterests, this));
+}
+
+void
+KademliaTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &KademliaTracer::PeriodicPrinter, this);
+}
+
+void
+KademliaTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+  Reset();
+
+  m_printEvent = Simulator::Schedule(m_period, &KademliaTracer::PeriodicPrinter, this);
+}
+
+void
+KademliaTracer::Reset()
+{
+  m_stats = kademlia::Stats();
+}
+
+void
+KademliaTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Type"
+     << "\t"
+     << "Value";
+}
+
+void
+KademliaTracer::Print(std::ostream& os) const
+{
+  if (!m_isConsumer) {
+    return;
+  }
+
+  Time time = Simulator::Now();
+  auto print = [&] (const char* type, auto value) {
+    os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << type << "\t" << value << "\n";
+  };
+  auto average = [] (double sum, uint64_t count) {
+    return count > 0 ? sum / count : 0.0;
+  };
+
+  uint64_t nFinished = m_stats.m_satisfied + m_stats.m_timedOut + m_stats.m_retransmitted;
+
+  print("Lookups", m_stats.m_lookups);
+  print("Satisfied", m_stats.m_satisfied);
+  print("TimedOut", m_stats.m_timedOut);
+  print("Retransmitted", m_stats.m_retransmitted);
+  print("Fallbacks", m_stats.m_fallbacks);
+  print("FallbackRatio", average(m_stats.m_fallbacks, nFinished));
+
+  print("IdHops", average(m_stats.m_idHops, m_stats.m_satisfied));
+  print("KademliaHops", average(m_stats.m_kademliaHops, m_stats.m_satisfied));
+  print("NdnHops", average(m_stats.m_ndnHops, m_stats.m_satisfied));
+  print("PathLength", average(m_stats.m_kademliaHops + m_stats.m_ndnHops, m_stats.m_satisfied));
+
+  print("ShortestPath", average(m_stats.m_shortestPathHops, m_stats.m_nPaths));
+  print("Stretch", average(m_stats.m_stretch, m_stats.m_nPaths));
+  print("MaxStretch", m_stats.m_maxStretch);
+}
+
+void
+KademliaTracer::LookupStart(const Interest& interest)
+{
+  uint32_t nonce = interest.getNonce();
+  if (g_requests.count(nonce) > 0) {
+    return;
+  }
+
+  // a retransmission with a new Nonce supersedes the previous lookup
+  auto lookup = m_lookups.find(interest.getName());
+  if (lookup != m_lookups.end()) {
+    auto request = g_requests.find(lookup->second);
+    if (request != g_requests.end()) {
+      ++m_stats.m_retransmitted;
+      m_stats.m_fallbacks += request->second.isFallback;
+      g_requests.erase(request);
+    }
+  }
+
+  m_isConsumer = true;
+  ++m_stats.m_lookups;
+  m_lookups[interest.getName()] = nonce;
+  g_requests[nonce] = kademlia::Request{this, 0, 0, 0, false, -1};
+}
+
+void
+KademliaTracer::IdHop(const Interest& interest, const Name& nextNodeId)
+{
+  auto request = g_requests.find(interest.getNonce());
+  if (request != g_requests.end()) {
+    ++request->second.idHops;
+  }
+}
+
+void
+KademliaTracer::AgentSwitch(const Interest& interest)
+{
+  auto request = g_requests.find(interest.getNonce());
+  if (request != g_requests.end()) {
+    request->second.isFallback = true;
+  }
+}
+
+void
+KademliaTracer::OutInterests(const Interest& interest, const Face& face)
+{
+  auto request = g_requests.find(interest.getNonce());
+  if (request == g_requests.end()) {
+    return;
+  }
+
+  if (face.getScope() == ::ndn::nfd::FACE_SCOPE_LOCAL) {
+    // Interest is delivered to a producer application
+    if (request->second.dataSource < 0) {
+      request->second.dataSource = m_nodePtr->GetId();
+    }
+  }
+  else if (interest.getProtocol() == KADEMLIA_PROTOCOL) {
+    ++request->second.kademliaHops;
+  }
+  else {
+    ++request->second.ndnHops;
+  }
+}
+
+void
+KademliaTracer::CsHits(const Interest& interest, const Data& data)
+{
+  auto request = g_requests.find(interest.getNonce());
+  if (request != g_requests.end() && request->second.dataSource < 0) {
+    request->second.dataSource = m_nodePtr->GetId();
+  }
+}
+
+void
+KademliaTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
+{
+  Finish(entry, true);
+}
+
+void
+KademliaTracer::TimedOutInterests(const nfd::pit::Entry& entry)
+{
+  Finish(entry, false);
+}
+
+void
+KademliaTracer::Finish(const nfd::pit::Entry& entry, bool isSatisfied)
+{
+  if (m_lookups.empty()) {
+    return;
+  }
+
+  for (const auto& in : entry.getInRecords()) {
+    auto i = g_requests.find(in.getLastNonce());
+    if (i == g_requests.end() || i->second.consumer != this) {
+      continue;
+    }
+    const kademlia::Request& request = i->second;
+
+    m_stats.m_fallbacks += request.isFallback;
+    if (!isSatisfied) {
+      ++m_stats.m_timedOut;
+    }
+    else {
+      ++m_stats.m_satisfied;
+      m_stats.m_idHops += request.idHops;
+      m_stats.m_kademliaHops += request.kademliaHops;
+      m_stats.m_ndnHops += request.ndnHops;
+
+      uint32_t pathLength = request.kademliaHops + request.ndnHops;
+      int32_t distance = request.dataSource < 0 ? -1 :
+                           GetDistance(m_nodePtr->GetId(), request.dataSource);
+      if (distance > 0) {
+        double stretch = static_cast<double>(pathLength) / distance;
+        ++m_stats.m_nPaths;
+        m_stats.m_shortestPathHops += distance;
+        m_stats.m_stretch += stretch;
+        m_stats.m_maxStretch = std::max(m_stats.m_maxStretch, stretch);
+      }
+    }
+
+    auto lookup = m_lookups.find(entry.getName());
+    if (lookup != m_lookups.end() && lookup->second == i->first) {
+      m_lookups.erase(lookup);
+    }
+    g_requests.erase(i);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_KADEMLIA_TRACER_H
+#define NDN_KADEMLIA_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <map>
+
+namespace nfd {
+namespace pit {
+class Entry;
+} // namespace pit
+} // namespace nfd
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+namespace kademlia {
+
+/// @cond include_hidden
+struct Stats {
+  uint64_t m_lookups = 0;
+  uint64_t m_satisfied = 0;
+  uint64_t m_timedOut = 0;
+  uint64_t m_retransmitted = 0;
+  uint64_t m_fallbacks = 0;
+
+  // sums over satisfied requests
+  uint64_t m_idHops = 0;
+  uint64_t m_kademliaHops = 0;
+  uint64_t m_ndnHops = 0;
+
+  // sums over satisfied requests with known Data source
+  uint64_t m_nPaths = 0;
+  uint64_t m_shortestPathHops = 0;
+  double m_stretch = 0.0;
+  double m_maxStretch = 0.0;
+};
+/// @endcond
+}
+
+/**
+ * @ingroup ndn-tracers
+ * @brief NDN tracer for ID-space lookups of KoNDNStrategy
+ *
+ * A request is an Interest, identified by its Nonce, for which KoNDNStrategy started an ID-space
+ * lookup on the consumer node.  The tracer follows the request through the KademliaIdHops,
+ * KademliaAgentSwitches and OutInterests trace sources of the nodes until the PIT entry on the
+ * consumer node is satisfied or times out, or the Interest is retransmitted with another Nonce.
+ *
+ * For each satisfied request, the path length is the number of links that the Interest
+ * traversed in Kademlia and in NDN mode, and the stretch is the ratio between the path length and
+ * the shortest-path hop count from the consumer to the node that returned the Data (producer, or
+ * Content Store hit).  The results are aggregated in memory per consumer node, and written every
+ * averaging period as the number of requests, fallbacks to NDN routing, and averages of hop
+ * counts and stretch.
+ *
+ * Hops are observed only on nodes with installed tracers, so paths are complete with InstallAll().
+ */
+class KademliaTracer : public SimpleRefCount<KademliaTracer> {
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every
+   *                        second)
+   */
+  static void
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every
+   *                        second)
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file,
+          Time averagingPeriod = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param outputStream Smart pointer to a stream
+   * @param averagingPeriod How often data will be written into the trace file (default, every
+   *                        second)
+   */
+  static Ptr<KademliaTracer>
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+          Time averagingPeriod = Seconds(1.0));
+
+  /**
+   * @brief Explicit request to remove all statically created tracers and pending requests
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param os    reference to the output stream
+   * @param node  pointer to the node
+   */
+  KademliaTracer(shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  ~KademliaTracer();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print statistics of the requests finished since the last period
+   *
+   * @param os reference to output stream
+   */
+  void
+  Print(std::ostream& os) const;
+
+private:
+  void
+  Connect();
+
+  void
+  SetAveragingPeriod(const Time& period);
+
+  void
+  Reset();
+
+  void
+  PeriodicPrinter();
+
+private:
+  void
+  LookupStart(const Interest& interest);
+
+  void
+  IdHop(const Interest& interest, const Name& nextNodeId);
+
+  void
+  AgentSwitch(const Interest& interest);
+
+  void
+  OutInterests(const Interest& interest, const Face& face);
+
+  void
+  CsHits(const Interest& interest, const Data& data);
+
+  void
+  SatisfiedInterests(const nfd::pit::Entry& entry, const Face& inFace, const Data& data);
+
+  void
+  TimedOutInterests(const nfd::pit::Entry& entry);
+
+  /**
+   * @brief Finish the requests of the consumer node that are pending in @p entry
+   */
+  void
+  Finish(const nfd::pit::Entry& entry, bool isSatisfied);
+
+private:
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+
+  shared_ptr<std::ostream> m_os;
+
+  Time m_period;
+  EventId m_printEvent;
+  kademlia::Stats m_stats;
+  bool m_isConsumer; ///< @brief whether any lookup was started on the node
+
+  std::map<Name, uint32_t> m_lookups; ///< @brief Nonce of the latest lookup for each Name
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_KADEMLIA_TRACER_H
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-l3-rate-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -26,10 +27,12 @@
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-block-header.hpp"
 
+#include "daemon/fw/face-table.hpp"
 #include "daemon/table/pit-entry.hpp"
 
-#include <fstream>
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
@@ -50,20 +53,9 @@ void
 L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
@@ -88,20 +80,9 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   using namespace std;
 
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
@@ -126,20 +107,9 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
   using namespace std;
 
   std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
   }
 
   Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
@@ -170,12 +140,20 @@ L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
 {
+  // faces created later (e.g., application faces) extend the array on their first packet
+  nfd::FaceId maxFaceId = nfd::face::INVALID_FACEID;
+  for (const Face& face : node->GetObject<L3Protocol>()->getFaceTable()) {
+    maxFaceId = std::max(maxFaceId, face.getId());
+  }
+  m_faceStats.resize(maxFaceId + 1);
+
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_faceStats(1)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -229,175 +207,182 @@ L3RateTracer::PrintHeader(std::ostream& os) const
 void
 L3RateTracer::Reset()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+  for (FaceStats& stats : m_faceStats) {
+    std::fill(std::begin(stats.packets), std::end(stats.packets), 0);
+    std::fill(std::begin(stats.bytes), std::end(stats.bytes), 0);
   }
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
-
-#define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
-                                                                                                   \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+void
+L3RateTracer::PrintStats(std::ostream& os, nfd::FaceId id, StatsType type,
+                         const char* printName) const
+{
+  FaceStats& stats = m_faceStats[id];
+  double period = m_period.ToDouble(Time::S);
+  stats.packetRate[type] =
+    /*new value*/ alpha * stats.packets[type] / period
+    + /*old value*/ (1 - alpha) * stats.packetRate[type];
+  stats.kilobyteRate[type] =
+    /*new value*/ alpha * stats.bytes[type] / period / 1024.0
+    + /*old value*/ (1 - alpha) * stats.kilobyteRate[type];
+
+  os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t";
+  if (id != nfd::face::INVALID_FACEID) {
+    os << id << "\t" << stats.description << "\t";
+  }
+  else {
+    os << "-1\tall\t";
+  }
+  os << printName << "\t" << stats.packetRate[type] << "\t" << stats.kilobyteRate[type] << "\t"
+     << stats.packets[type] << "\t" << stats.bytes[type] / 1024.0 << "\n";
+}
 
 void
 L3RateTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
-
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
+  for (nfd::FaceId id = 0; id < m_faceStats.size(); ++id) {
+    if (id == nfd::face::INVALID_FACEID || !m_faceStats[id].isUsed)
       continue;
 
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
+    PrintStats(os, id, IN_INTERESTS, "InInterests");
+    PrintStats(os, id, OUT_INTERESTS, "OutInterests");
 
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
+    PrintStats(os, id, IN_DATA, "InData");
+    PrintStats(os, id, OUT_DATA, "OutData");
 
-    PRINTER("InNacks", m_inNack);
-    PRINTER("OutNacks", m_outNack);
+    PrintStats(os, id, IN_NACKS, "InNacks");
+    PrintStats(os, id, OUT_NACKS, "OutNacks");
 
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+    PrintStats(os, id, IN_SATISFIED_INTERESTS, "InSatisfiedInterests");
+    PrintStats(os, id, IN_TIMED_OUT_INTERESTS, "InTimedOutInterests");
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+    PrintStats(os, id, OUT_SATISFIED_INTERESTS, "OutSatisfiedInterests");
+    PrintStats(os, id, OUT_TIMED_OUT_INTERESTS, "OutTimedOutInterests");
   }
 
-  {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
-    }
+  if (!m_faceStats.empty() && m_faceStats[nfd::face::INVALID_FACEID].isUsed) {
+    PrintStats(os, nfd::face::INVALID_FACEID, IN_SATISFIED_INTERESTS, "SatisfiedInterests");
+    PrintStats(os, nfd::face::INVALID_FACEID, IN_TIMED_OUT_INTERESTS, "TimedOutInterests");
   }
 }
 
+inline L3RateTracer::FaceStats&
+L3RateTracer::GetFaceStats(const Face& face)
+{
+  nfd::FaceId id = face.getId();
+  if (id < m_faceStats.size() && m_faceStats[id].isUsed) {
+    return m_faceStats[id];
+  }
+  return AddFaceStats(face);
+}
+
+L3RateTracer::FaceStats&
+L3RateTracer::AddFaceStats(const Face& face)
+{
+  nfd::FaceId id = face.getId();
+  if (id >= m_faceStats.size()) {
+    m_faceStats.resize(std::max<size_t>(id + 1, m_faceStats.size() * 2));
+  }
+
+  FaceStats& stats = m_faceStats[id];
+  stats.isUsed = true;
+  stats.description = boost::lexical_cast<std::string>(face.getLocalUri());
+  return stats;
+}
+
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outInterests++;
+  FaceStats& stats = GetFaceStats(face);
+  ++stats.packets[OUT_INTERESTS];
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outInterests +=
-      interest.wireEncode().size();
+    stats.bytes[OUT_INTERESTS] += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inInterests++;
+  FaceStats& stats = GetFaceStats(face);
+  ++stats.packets[IN_INTERESTS];
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inInterests +=
-      interest.wireEncode().size();
+    stats.bytes[IN_INTERESTS] += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outData++;
+  FaceStats& stats = GetFaceStats(face);
+  ++stats.packets[OUT_DATA];
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outData +=
-      data.wireEncode().size();
+    const Block& wire = data.wireEncode();
+    stats.bytes[OUT_DATA] += wire.size() + BlockHeader::getVirtualPayloadPadding(wire);
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inData++;
+  FaceStats& stats = GetFaceStats(face);
+  ++stats.packets[IN_DATA];
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inData +=
-      data.wireEncode().size();
+    const Block& wire = data.wireEncode();
+    stats.bytes[IN_DATA] += wire.size() + BlockHeader::getVirtualPayloadPadding(wire);
   }
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
+  FaceStats& stats = GetFaceStats(face);
+  ++stats.packets[OUT_NACKS];
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes[OUT_NACKS] += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
+  FaceStats& stats = GetFaceStats(face);
+  ++stats.packets[IN_NACKS];
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes[IN_NACKS] += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
+  m_faceStats[nfd::face::INVALID_FACEID].isUsed = true;
+  ++m_faceStats[nfd::face::INVALID_FACEID].packets[IN_SATISFIED_INTERESTS];
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+    ++GetFaceStats(in.getFace()).packets[IN_SATISFIED_INTERESTS];
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+    ++GetFaceStats(out.getFace()).packets[OUT_SATISFIED_INTERESTS];
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
+  m_faceStats[nfd::face::INVALID_FACEID].isUsed = true;
+  ++m_faceStats[nfd::face::INVALID_FACEID].packets[IN_TIMED_OUT_INTERESTS];
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    ++GetFaceStats(in.getFace()).packets[IN_TIMED_OUT_INTERESTS];
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
-  }
-}
-
-void
-L3RateTracer::AddInfo(const Face& face)
-{
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+    ++GetFaceStats(out.getFace()).packets[OUT_TIMED_OUT_INTERESTS];
   }
 }
 
@@ -29,8 +29,8 @@
 #include "ns3/node-container.h"
 
 #include <tuple>
-#include <map>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -38,6 +38,9 @@ namespace ndn {
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
+ *
+ * Per-face counters are kept in an array indexed by FaceId, so that a traced packet costs
+ * only a couple of increments.  Rates are smoothed at print time.
  */
 class L3RateTracer : public L3Tracer {
 public:
@@ -161,16 +164,48 @@ private:
   void
   Reset();
 
+  enum StatsType {
+    IN_INTERESTS,
+    OUT_INTERESTS,
+    IN_DATA,
+    OUT_DATA,
+    IN_NACKS,
+    OUT_NACKS,
+    IN_SATISFIED_INTERESTS,
+    IN_TIMED_OUT_INTERESTS,
+    OUT_SATISFIED_INTERESTS,
+    OUT_TIMED_OUT_INTERESTS,
+    N_STATS_TYPES
+  };
+
+  struct FaceStats {
+    bool isUsed = false;
+    std::string description; // needed, because face may no longer exists at the time of printing
+
+    uint64_t packets[N_STATS_TYPES] = {};
+    uint64_t bytes[N_STATS_TYPES] = {};
+    double packetRate[N_STATS_TYPES] = {};   ///< @brief smoothed packets per second
+    double kilobyteRate[N_STATS_TYPES] = {}; ///< @brief smoothed kilobytes per second
+  };
+
+  FaceStats&
+  GetFaceStats(const Face& face);
+
+  FaceStats&
+  AddFaceStats(const Face& face);
+
   void
-  AddInfo(const Face& face);
+  PrintStats(std::ostream& os, nfd::FaceId id, StatsType type, const char* printName) const;
 
 private:
   shared_ptr<std::ostream> m_os;
   Time m_period;
   EventId m_printEvent;
 
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  /**
+   * @brief Per-face statistics indexed by FaceId; INVALID_FACEID entry holds node-wide totals
+   */
+  mutable std::vector<FaceStats> m_faceStats;
 };
 
 } // namespace ndn
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-table-memory-tracer.hpp"
+#include "ndn-trace-sink.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TableMemoryTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<TableMemoryTracer>>>>
+  g_tracers;
+
+void
+TableMemoryTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+TableMemoryTracer::InstallAll(const std::string& file, Time period /* = Seconds(1.0)*/)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+  Install(nodes, file, period);
+}
+
+void
+TableMemoryTracer::Install(const NodeContainer& nodes, const std::string& file,
+                           Time period /* = Seconds(1.0)*/)
+{
+  std::list<Ptr<TableMemoryTracer>> tracers;
+  shared_ptr<std::ostream> outputStream = TraceSink::Open(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<TableMemoryTracer> trace = Install(*node, outputStream, period);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+TableMemoryTracer::Install(Ptr<Node> node, const std::string& file,
+                           Time period /* = Seconds(1.0)*/)
+{
+  Install(NodeContainer(node), file, period);
+}
+
+Ptr<TableMemoryTracer>
+TableMemoryTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                           Time period /* = Seconds(1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<TableMemoryTracer> trace = Create<TableMemoryTracer>(outputStream, node);
+  trace->SetPeriod(period);
+
+  return trace;
+}
+
+TableMemoryTracer::TableMemoryTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+
+  Ptr<L3Protocol> ndn = m_nodePtr->GetObject<L3Protocol>();
+  if (ndn == nullptr) {
+    NS_LOG_WARN("NDN stack is not installed on node " << m_node << ", tables are not traced");
+  }
+  else {
+    m_forwarder = ndn->getForwarder();
+  }
+}
+
+TableMemoryTracer::~TableMemoryTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+TableMemoryTracer::SetPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &TableMemoryTracer::PeriodicPrinter, this);
+}
+
+void
+TableMemoryTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+
+  m_printEvent = Simulator::Schedule(m_period, &TableMemoryTracer::PeriodicPrinter, this);
+}
+
+void
+TableMemoryTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Table"
+     << "\t"
+     << "Entries"
+     << "\t"
+     << "Bytes";
+}
+
+#define PRINTER(printName, table)                                                                  \
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t"                    \
+     << table.size() << "\t" << table.getMemoryUsage() << "\n";
+
+void
+TableMemoryTracer::Print(std::ostream& os) const
+{
+  if (m_forwarder == nullptr) {
+    return;
+  }
+
+  Time time = Simulator::Now();
+
+  PRINTER("NameTree", m_forwarder->getNameTree());
+  PRINTER("Pit", m_forwarder->getPit());
+  PRINTER("Fib", m_forwarder->getFib());
+  PRINTER("Cs", m_forwarder->getCs());
+  PRINTER("Measurements", m_forwarder->getMeasurements());
+  PRINTER("DeadNonceList", m_forwarder->getDeadNonceList());
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/log.h"
+#include "core/config.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#ifdef HAVE_BOOST_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif // HAVE_BOOST_ZSTD
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Double-buffered stream buffer, drained by a writer thread
+ *
+ * The simulation thread fills the put area (m_front).  When it is full or flushed, it is
+ * swapped with m_back, which is then owned by the writer thread until m_hasPending is reset.
+ */
+class TraceSink::Buffer : public std::streambuf {
+public:
+  Buffer(const std::string& file, Format format, Compression compression, size_t bufferSize)
+    : m_format(format)
+    , m_front(bufferSize)
+    , m_back(bufferSize)
+    , m_backSize(0)
+    , m_shouldFlush(false)
+    , m_hasPending(false)
+    , m_isClosing(false)
+  {
+    boost::iostreams::file_sink sink(file, std::ios_base::out | std::ios_base::trunc |
+                                             std::ios_base::binary);
+    if (!sink.is_open()) {
+      throw std::runtime_error("File " + file + " cannot be opened for writing");
+    }
+
+    switch (compression) {
+    case NONE:
+      break;
+    case GZIP:
+      m_out.push(boost::iostreams::gzip_compressor());
+      break;
+    case ZSTD:
+#ifdef HAVE_BOOST_ZSTD
+      m_out.push(boost::iostreams::zstd_compressor());
+      break;
+#else
+      throw std::runtime_error("zstd compression requires Boost.Iostreams built with zstd support");
+#endif // HAVE_BOOST_ZSTD
+    }
+    m_out.push(sink);
+
+    setp(m_front.data(), m_front.data() + m_front.size());
+    m_writer = std::thread(&Buffer::run, this);
+  }
+
+  ~Buffer()
+  {
+    handOver(false);
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isClosing = true;
+    }
+    m_cv.notify_all();
+    m_writer.join();
+
+    // finishes the compressed stream and closes the file
+    m_out.reset();
+  }
+
+protected:
+  int_type
+  overflow(int_type ch) override
+  {
+    handOver(false);
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  /**
+   * @brief Hand over the buffered output and wait until it is written to the file
+   */
+  int
+  sync() override
+  {
+    handOver(true);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return !m_hasPending; });
+    return 0;
+  }
+
+private:
+  void
+  handOver(bool shouldFlush)
+  {
+    size_t size = pptr() - pbase();
+    if (size == 0 && !shouldFlush) {
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return !m_hasPending; });
+
+      m_front.swap(m_back);
+      m_backSize = size;
+      m_shouldFlush = shouldFlush;
+      m_hasPending = true;
+    }
+    m_cv.notify_all();
+
+    setp(m_front.data(), m_front.data() + m_front.size());
+  }
+
+  void
+  run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_cv.wait(lock, [this] { return m_hasPending || m_isClosing; });
+      if (!m_hasPending) {
+        break;
+      }
+
+      lock.unlock();
+      if (m_format == CSV) {
+        std::replace(m_back.begin(), m_back.begin() + m_backSize, '\t', ',');
+      }
+      m_out.write(m_back.data(), m_backSize);
+      if (m_shouldFlush) {
+        m_out.flush();
+      }
+      lock.lock();
+
+      m_hasPending = false;
+      m_cv.notify_all();
+    }
+  }
+
+private:
+  Format m_format;
+  boost::iostreams::filtering_ostream m_out; ///< @brief accessed only by the writer thread
+
+  std::vector<char> m_front;
+  std::vector<char> m_back;
+  size_t m_backSize;
+  bool m_shouldFlush;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_hasPending;
+  bool m_isClosing;
+  std::thread m_writer;
+};
+
+shared_ptr<std::ostream>
+TraceSink::Open(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  std::string name = file;
+  Compression compression = NONE;
+  if (boost::ends_with(name, ".gz")) {
+    compression = GZIP;
+    name.resize(name.size() - 3);
+  }
+  else if (boost::ends_with(name, ".zst")) {
+    compression = ZSTD;
+    name.resize(name.size() - 4);
+  }
+  Format format = boost::ends_with(name, ".csv") ? CSV : TSV;
+
+  try {
+    return make_shared<TraceSink>(file, format, compression);
+  }
+  catch (const std::runtime_error& e) {
+    NS_LOG_ERROR(e.what() << ". Tracing disabled");
+    return nullptr;
+  }
+}
+
+TraceSink::TraceSink(const std::string& file, Format format, Compression compression,
+                     size_t bufferSize)
+  : std::ostream(nullptr)
+  , m_buffer(new Buffer(file, format, compression, bufferSize))
+{
+  rdbuf(m_buffer.get());
+}
+
+TraceSink::~TraceSink()
+{
+  rdbuf(nullptr);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_SINK_H
+#define NDN_TRACE_SINK_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <memory>
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Output stream shared by all tracers writing to the same file
+ *
+ * Formatted output is collected in a buffer on the simulation thread.  Full buffers are
+ * handed over to a background thread, which optionally converts and compresses them and
+ * writes them to the file, while the simulation continues with the second buffer.
+ *
+ * Tracers write tab-separated rows.  In CSV format, tabs are converted to commas by the
+ * background thread.
+ */
+class TraceSink : public std::ostream {
+public:
+  enum Format {
+    TSV,
+    CSV
+  };
+
+  enum Compression {
+    NONE,
+    GZIP,
+    ZSTD
+  };
+
+  /**
+   * @brief Open output stream for tracers
+   *
+   * @param file name of the output file, or "-" to write (synchronously) to std::cout.
+   *             The format and compression are selected by the extensions of the file name:
+   *             ".csv" selects CSV format, ".gz" gzip and ".zst" zstd compression
+   *             (e.g., "rate-trace.csv.gz").  Any other name is written uncompressed as-is.
+   *
+   * @return output stream, or nullptr if the file cannot be opened
+   */
+  static shared_ptr<std::ostream>
+  Open(const std::string& file);
+
+  /**
+   * @brief Open @p file for writing
+   * @throw std::runtime_error the file cannot be opened, or @p compression is not supported
+   */
+  TraceSink(const std::string& file, Format format, Compression compression,
+            size_t bufferSize = 1 << 20);
+
+  /**
+   * @brief Write out the buffered output and close the file
+   */
+  ~TraceSink();
+
+private:
+  class Buffer;
+  std::unique_ptr<Buffer> m_buffer;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_SINK_H
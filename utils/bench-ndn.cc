@@ -0,0 +1,544 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks NDN packet encoding and the NFD tables on the
+// forwarding path, and reports the time and the number of heap allocations
+// per operation for each case, optionally as JSON.
+// Sample usage:  ./waf --run 'bench-ndn --names=100000 --json=bench-ndn.json'
+
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+#include "ns3/ndnSIM/model/ndn-block-header.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/dead-nonce-list.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/name-tree.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/pit.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// Number of heap allocations made through operator new.
+static uint64_t g_allocations = 0;
+
+/// Results of the benchmarked operations, to keep them from being optimized away.
+static volatile uint64_t g_sink = 0;
+
+void *
+operator new (std::size_t size)
+{
+  ++g_allocations;
+  void *p = std::malloc (size == 0 ? 1 : size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+  std::free (p);
+}
+
+/// Runs benchmark cases and collects their results
+class BenchRunner
+{
+public:
+  /**
+   * Constructor
+   * \param groups comma-separated list of groups to run; empty to run all
+   * \param table the output stream of the results table
+   */
+  BenchRunner (const std::string &groups, std::ostream &table)
+    : m_table (table)
+  {
+    std::istringstream is (groups);
+    std::string group;
+    while (std::getline (is, group, ','))
+      {
+        m_groups.push_back (group);
+      }
+  }
+
+  /**
+   * \param group the group name
+   * \returns true if the cases of \p group should be run
+   */
+  bool IsEnabled (const std::string &group) const
+  {
+    return m_groups.empty ()
+      || std::find (m_groups.begin (), m_groups.end (), group) != m_groups.end ();
+  }
+
+  /// Print the header of the results table
+  void PrintHeader () const
+  {
+    m_table << std::left << std::setw (32) << "Case" << std::right
+            << std::setw (10) << "Ops" << std::setw (12) << "ns/op" << std::setw (12) << "allocs/op"
+            << std::endl;
+  }
+
+  /**
+   * Time \p ops calls of \p op, passing the operation index
+   * \param name the case name
+   * \param ops the number of operations
+   * \param op the operation
+   */
+  template <typename Op>
+  void Run (const std::string &name, uint32_t ops, Op op)
+  {
+    uint64_t allocations = g_allocations;
+    auto start = std::chrono::steady_clock::now ();
+    for (uint32_t i = 0; i < ops; ++i)
+      {
+        op (i);
+      }
+    auto end = std::chrono::steady_clock::now ();
+
+    Result result;
+    result.name = name;
+    result.ops = ops;
+    result.nsPerOp = std::chrono::duration<double, std::nano> (end - start).count () / std::max (ops, 1u);
+    result.allocsPerOp = static_cast<double> (g_allocations - allocations) / std::max (ops, 1u);
+    m_results.push_back (result);
+
+    m_table << std::left << std::setw (32) << name << std::right
+            << std::setw (10) << ops
+            << std::fixed << std::setprecision (1) << std::setw (12) << result.nsPerOp
+            << std::setprecision (2) << std::setw (12) << result.allocsPerOp
+            << std::endl;
+  }
+
+  /**
+   * Write the results as a JSON object
+   * \param os the output stream
+   * \param parameters the benchmark parameters, as name and value pairs
+   */
+  void WriteJson (std::ostream &os,
+                  const std::vector<std::pair<std::string, uint32_t> > &parameters) const
+  {
+    os << "{\n  \"benchmark\": \"bench-ndn\",\n  \"parameters\": {";
+    for (std::size_t i = 0; i < parameters.size (); ++i)
+      {
+        os << (i > 0 ? ", " : "") << "\"" << parameters[i].first << "\": " << parameters[i].second;
+      }
+    os << "},\n  \"results\": [";
+    for (std::size_t i = 0; i < m_results.size (); ++i)
+      {
+        const Result &result = m_results[i];
+        os << (i > 0 ? "," : "") << "\n    {\"name\": \"" << result.name << "\""
+           << ", \"ops\": " << result.ops
+           << std::fixed << std::setprecision (3)
+           << ", \"ns_per_op\": " << result.nsPerOp
+           << ", \"allocs_per_op\": " << result.allocsPerOp << "}";
+      }
+    os << "\n  ]\n}\n";
+  }
+
+private:
+  /// Result of one case
+  struct Result
+  {
+    std::string name;   ///< case name
+    uint32_t ops;       ///< number of operations
+    double nsPerOp;     ///< mean time per operation
+    double allocsPerOp; ///< mean number of heap allocations per operation
+  };
+
+  std::ostream &m_table;             ///< output stream of the results table
+  std::vector<std::string> m_groups; ///< groups to run
+  std::vector<Result> m_results;     ///< results of the cases run so far
+};
+
+/**
+ * \param i the index
+ * \returns a hierarchical name, as requested by consumers
+ */
+static ::ndn::Name
+MakeName (uint32_t i)
+{
+  return ::ndn::Name ("/bench")
+    .append (std::to_string (i % 16))
+    .append (std::to_string (i % 1021))
+    .appendSequenceNumber (i);
+}
+
+/**
+ * \param rng the random number generator
+ * \returns a random Kademlia ID: 40 hexadecimal digits, as produced by calcSha1Hash
+ */
+static std::string
+MakeId (std::mt19937 &rng)
+{
+  static const char digits[] = "0123456789abcdef";
+  std::string id (40, '0');
+  for (char &c : id)
+    {
+      c = digits[rng () % 16];
+    }
+  return id;
+}
+
+/**
+ * \param name the name
+ * \param seq the sequence number
+ * \returns an Interest carrying the KoNDN fields, as sent by the consumers
+ */
+static std::shared_ptr<::ndn::Interest>
+MakeInterest (const ::ndn::Name &name, uint32_t seq)
+{
+  auto interest = std::make_shared<::ndn::Interest> (name);
+  interest->setCanBePrefix (false);
+  interest->setNonce (seq);
+  interest->setInterestLifetime (::ndn::time::seconds (2));
+  interest->setHashedName (::ndn::Name ("/0123456789abcdef0123456789abcdef01234567"));
+  interest->setProtocol ("ndn");
+  interest->setAgentNodeID (::ndn::Name ("/89abcdef0123456789abcdef0123456789abcdef"));
+  interest->setDestinationNodeID (::ndn::Name ("/fedcba9876543210fedcba9876543210fedcba98"));
+  return interest;
+}
+
+/**
+ * \param name the name
+ * \returns an encoded Data with a virtual payload and a fake signature, as sent by the producers
+ */
+static std::shared_ptr<::ndn::Data>
+MakeData (const ::ndn::Name &name)
+{
+  auto data = std::make_shared<::ndn::Data> (name);
+  data->setFreshnessPeriod (::ndn::time::seconds (10));
+  data->setVirtualContent (1024);
+
+  ::ndn::SignatureInfo signatureInfo (static_cast< ::ndn::tlv::SignatureTypeValue> (255));
+  ::ndn::Signature signature;
+  signature.setInfo (signatureInfo);
+  signature.setValue (::ndn::makeNonNegativeIntegerBlock (::ndn::tlv::SignatureValue, 0));
+  data->setSignature (signature);
+  data->wireEncode ();
+  return data;
+}
+
+/// Interest and Data encoding and decoding
+static void
+BenchPackets (BenchRunner &runner, uint32_t n)
+{
+  std::vector<std::shared_ptr<::ndn::Interest> > interests;
+  std::vector<std::shared_ptr<::ndn::Data> > datas;
+  std::vector<::ndn::Block> interestWires;
+  std::vector<::ndn::Block> dataWires;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      interests.push_back (MakeInterest (MakeName (i), i));
+      datas.push_back (MakeData (MakeName (i)));
+      interestWires.push_back (interests.back ()->wireEncode ());
+      dataWires.push_back (datas.back ()->wireEncode ());
+    }
+
+  runner.Run ("interest-encode", n, [&] (uint32_t i) {
+    // a new nonce discards the cached wire encoding
+    interests[i]->setNonce (i + 1);
+    g_sink += interests[i]->wireEncode ().size ();
+  });
+  runner.Run ("interest-decode", n, [&] (uint32_t i) {
+    ::ndn::Interest interest (interestWires[i]);
+    g_sink += interest.getHashedName ().size ();
+  });
+  runner.Run ("data-encode", n, [&] (uint32_t i) {
+    // a new freshness period discards the cached wire encoding
+    datas[i]->setFreshnessPeriod (::ndn::time::seconds (11));
+    g_sink += datas[i]->wireEncode ().size ();
+  });
+  runner.Run ("data-decode", n, [&] (uint32_t i) {
+    ::ndn::Data data (dataWires[i]);
+    g_sink += data.getVirtualContentSize ();
+  });
+}
+
+/// BlockHeader serialization into and deserialization from ns-3 packets
+static void
+BenchBlockHeader (BenchRunner &runner, uint32_t n)
+{
+  std::vector<::ndn::Block> interestWires;
+  std::vector<::ndn::Block> dataWires;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      interestWires.push_back (MakeInterest (MakeName (i), i)->wireEncode ());
+      dataWires.push_back (MakeData (MakeName (i))->wireEncode ());
+    }
+
+  std::vector<Ptr<Packet> > packets (n);
+  runner.Run ("block-header-serialize-interest", n, [&] (uint32_t i) {
+    packets[i] = Create<Packet> ();
+    packets[i]->AddHeader (ns3::ndn::BlockHeader (interestWires[i]));
+  });
+  runner.Run ("block-header-deserialize-interest", n, [&] (uint32_t i) {
+    ns3::ndn::BlockHeader header;
+    packets[i]->PeekHeader (header);
+    g_sink += header.getBlock ().size ();
+  });
+  runner.Run ("block-header-serialize-data", n, [&] (uint32_t i) {
+    packets[i] = Create<Packet> ();
+    packets[i]->AddHeader (ns3::ndn::BlockHeader (dataWires[i]));
+  });
+  runner.Run ("block-header-deserialize-data", n, [&] (uint32_t i) {
+    ns3::ndn::BlockHeader header;
+    packets[i]->PeekHeader (header);
+    g_sink += header.getBlock ().size ();
+  });
+}
+
+/// NameTree insertion, exact match and longest prefix match
+static void
+BenchNameTree (BenchRunner &runner, uint32_t n)
+{
+  std::vector<::ndn::Name> names;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      names.push_back (MakeName (i));
+    }
+
+  nfd::NameTree nameTree;
+  runner.Run ("name-tree-insert", n, [&] (uint32_t i) {
+    g_sink += nameTree.lookup (names[i]).getName ().size ();
+  });
+  runner.Run ("name-tree-find-exact", n, [&] (uint32_t i) {
+    g_sink += nameTree.findExactMatch (names[i]) != nullptr;
+  });
+  runner.Run ("name-tree-find-lpm", n, [&] (uint32_t i) {
+    // the last component is not in the tree
+    g_sink += nameTree.findLongestPrefixMatch (names[i].getPrefix (-1).appendNumber (i)) != nullptr;
+  });
+}
+
+/// Kademlia next hop list lookup over the node IDs in the NameTree
+static void
+BenchKademlia (BenchRunner &runner, uint32_t nodes, uint32_t lookups)
+{
+  std::mt19937 rng (1);
+  nfd::NameTree nameTree;
+  for (uint32_t i = 0; i < nodes; ++i)
+    {
+      nameTree.lookup (::ndn::Name ("/" + MakeId (rng)));
+    }
+  std::string currentId = MakeId (rng);
+  std::vector<::ndn::Name> contents;
+  for (uint32_t i = 0; i < lookups; ++i)
+    {
+      contents.push_back (::ndn::Name ("/" + MakeId (rng)));
+    }
+
+  runner.Run ("kademlia-find-id-list", lookups, [&] (uint32_t i) {
+    g_sink += nameTree.findLongestIDMatchList (contents[i], currentId).size ();
+  });
+}
+
+/// Content Store insertion, exact match lookup and insertion with eviction, under each policy
+static void
+BenchCs (BenchRunner &runner, uint32_t capacity)
+{
+  std::vector<std::shared_ptr<::ndn::Data> > datas;
+  std::vector<std::shared_ptr<::ndn::Interest> > interests;
+  for (uint32_t i = 0; i < 2 * capacity; ++i)
+    {
+      datas.push_back (MakeData (MakeName (i)));
+      interests.push_back (MakeInterest (MakeName (i), i));
+    }
+
+  for (const std::string &policy : nfd::cs::Policy::getPolicyNames ())
+    {
+      nfd::cs::Cs cs (capacity);
+      cs.setPolicy (nfd::cs::Policy::create (policy));
+
+      runner.Run ("cs-insert-" + policy, capacity, [&] (uint32_t i) {
+        cs.insert (*datas[i]);
+      });
+      runner.Run ("cs-find-" + policy, capacity, [&] (uint32_t i) {
+        cs.find (*interests[i],
+                 [] (const ::ndn::Interest &, const ::ndn::Data &) { ++g_sink; },
+                 [] (const ::ndn::Interest &) {});
+      });
+      // the store is full, so that each insertion evicts an entry
+      runner.Run ("cs-evict-" + policy, capacity, [&] (uint32_t i) {
+        cs.insert (*datas[capacity + i]);
+      });
+    }
+}
+
+/// PIT insertion, and satisfaction and erasure by Data
+static void
+BenchPit (BenchRunner &runner, uint32_t n)
+{
+  std::vector<std::shared_ptr<::ndn::Interest> > interests;
+  std::vector<std::shared_ptr<::ndn::Data> > datas;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      interests.push_back (MakeInterest (MakeName (i), i));
+      datas.push_back (MakeData (MakeName (i)));
+    }
+
+  nfd::NameTree nameTree;
+  nfd::pit::Pit pit (nameTree);
+  runner.Run ("pit-insert", n, [&] (uint32_t i) {
+    g_sink += pit.insert (*interests[i]).second;
+  });
+  runner.Run ("pit-satisfy", n, [&] (uint32_t i) {
+    for (const auto &entry : pit.findAllDataMatches (*datas[i]))
+      {
+        pit.erase (entry.get ());
+        ++g_sink;
+      }
+  });
+}
+
+/// Dead Nonce List insertion and lookup, with the list and with the Bloom filters
+static void
+BenchDeadNonceList (BenchRunner &runner, uint32_t n)
+{
+  std::vector<::ndn::Name> names;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      names.push_back (MakeName (i));
+    }
+
+  nfd::DeadNonceList list;
+  runner.Run ("dnl-add", n, [&] (uint32_t i) {
+    list.add (names[i], i);
+  });
+  runner.Run ("dnl-has", n, [&] (uint32_t i) {
+    g_sink += list.has (names[i], i);
+  });
+
+  nfd::DeadNonceList filter;
+  filter.enableFilter (n, 0.001);
+  runner.Run ("dnl-filter-add", n, [&] (uint32_t i) {
+    filter.add (names[i], i);
+  });
+  runner.Run ("dnl-filter-has", n, [&] (uint32_t i) {
+    g_sink += filter.has (names[i], i);
+  });
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t names = 10000;
+  uint32_t kademliaNodes = 1000;
+  uint32_t kademliaLookups = 100;
+  uint32_t csSize = 10000;
+  std::string groups;
+  std::string json;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark NDN packet encoding and NFD table operations.\n"
+             "Groups: packets, block-header, name-tree, kademlia, cs, pit, dnl");
+  cmd.AddValue ("names", "number of names, packets and table entries per case", names);
+  cmd.AddValue ("kademliaNodes", "number of node IDs in the name tree", kademliaNodes);
+  cmd.AddValue ("kademliaLookups", "number of Kademlia next hop lookups", kademliaLookups);
+  cmd.AddValue ("csSize", "Content Store capacity", csSize);
+  cmd.AddValue ("groups", "comma-separated list of groups to run (default: all)", groups);
+  cmd.AddValue ("json", "write results as JSON to this file ('-' for stdout, "
+                "the table then goes to stderr)", json);
+  cmd.Parse (argc, argv);
+
+  // keep stdout a valid JSON document when the JSON is written there
+  BenchRunner runner (groups, json == "-" ? std::cerr : std::cout);
+  runner.PrintHeader ();
+
+  if (runner.IsEnabled ("packets"))
+    {
+      BenchPackets (runner, names);
+    }
+  if (runner.IsEnabled ("block-header"))
+    {
+      BenchBlockHeader (runner, names);
+    }
+  if (runner.IsEnabled ("name-tree"))
+    {
+      BenchNameTree (runner, names);
+    }
+  if (runner.IsEnabled ("kademlia"))
+    {
+      BenchKademlia (runner, kademliaNodes, kademliaLookups);
+    }
+  if (runner.IsEnabled ("cs"))
+    {
+      BenchCs (runner, csSize);
+    }
+  if (runner.IsEnabled ("pit"))
+    {
+      BenchPit (runner, names);
+    }
+  if (runner.IsEnabled ("dnl"))
+    {
+      BenchDeadNonceList (runner, names);
+    }
+
+  // the tables schedule their timers in the simulator
+  Simulator::Destroy ();
+
+  if (!json.empty ())
+    {
+      std::vector<std::pair<std::string, uint32_t> > parameters = {
+        {"names", names},
+        {"kademliaNodes", kademliaNodes},
+        {"kademliaLookups", kademliaLookups},
+        {"csSize", csSize},
+      };
+      if (json == "-")
+        {
+          runner.WriteJson (std::cout, parameters);
+        }
+      else
+        {
+          std::ofstream os (json.c_str ());
+          if (!os)
+            {
+              std::cerr << "Cannot open " << json << " for writing" << std::endl;
+              return 1;
+            }
+          runner.WriteJson (os, parameters);
+        }
+    }
+
+  return 0;
+}